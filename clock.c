@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   clock.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 12:05:19 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 01:40:06 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Raw reading of the source: microseconds for CLK_MONO and CLK_RAW, ticks for
+ * CLK_TSC.
+ */
+static long long	read_source(int source)
+{
+	struct timespec	ts;
+
+	if (source == CLK_TSC)
+	{
+# if PHILO_HAS_TSC
+
+		return ((long long)__rdtsc());
+# endif
+	}
+	if (source == CLK_RAW)
+		clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+	else
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000LL + ts.tv_nsec / 1000);
+}
+
+/**
+ * Measures how many microseconds a TSC tick lasts against CLOCK_MONOTONIC.
+ * 20ms are enough for an error well below the microsecond over the length of
+ * any simulation.
+ */
+static void	tsc_calibrate(t_clock *clock)
+{
+	long long	mono;
+	long long	tsc;
+
+	mono = read_source(CLK_MONO);
+	tsc = read_source(CLK_TSC);
+	usleep(20000);
+	mono = read_source(CLK_MONO) - mono;
+	tsc = read_source(CLK_TSC) - tsc;
+	clock->us_per_tick = (double)mono / (double)tsc;
+}
+
+static void	take_origin(t_clock *clock)
+{
+	clock->mono_origin = read_source(CLK_MONO);
+	clock->origin = read_source(clock->source);
+}
+
+/**
+ * Sets up the clock of the simulation and takes its origin: every time we
+ * read from now on is in microseconds since this call.
+ * CLK_MONO and CLK_RAW never jump (unlike gettimeofday under NTP), CLK_RAW
+ * is not even slewed. CLK_TSC reads the cpu time stamp counter, calibrated
+ * once here, which avoids the vDSO call; it falls back on CLK_MONO where
+ * there is no TSC.
+ * The spin of sleep_until is calibrated here too, before the final origin.
+ * CLK_VIRTUAL starts at 0 and never moves by itself: there is nothing to
+ * calibrate, nor to spin on.
+ */
+void	clock_setup(t_clock *clock, int source)
+{
+	if (source == CLK_TSC && !PHILO_HAS_TSC)
+		source = CLK_MONO;
+	clock->source = source;
+	clock->us_per_tick = 1;
+	atomic_init(&clock->virtual_now, 0);
+	if (source == CLK_VIRTUAL)
+	{
+		clock->spin_us = 0;
+		clock->origin = 0;
+		clock->mono_origin = read_source(CLK_MONO);
+		return ;
+	}
+	if (source == CLK_TSC)
+		tsc_calibrate(clock);
+	take_origin(clock);
+	sleep_calibrate(clock);
+	take_origin(clock);
+}
+
+long long	clock_now_us(const t_clock *clock)
+{
+	if (clock->source == CLK_VIRTUAL)
+		return (atomic_load_explicit(&clock->virtual_now,
+				memory_order_acquire));
+	if (clock->source == CLK_TSC)
+		return ((long long)((read_source(CLK_TSC) - clock->origin)
+			* clock->us_per_tick));
+	return (read_source(clock->source) - clock->origin);
+}
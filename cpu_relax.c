@@ -0,0 +1,31 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   cpu_relax.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:28:04 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:28:04 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Busy-wait hint for the spinning loops (PAUSE on x86).
+ */
+#if PHILO_HAS_TSC
+
+void	cpu_relax(void)
+{
+	_mm_pause();
+}
+
+#else
+
+void	cpu_relax(void)
+{
+}
+
+#endif
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   futex.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:48:55 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+#ifdef __linux__
+
+/**
+ * Thin wrappers around the futex syscall: sleep while *addr == val (for at
+ * most timeout_us, forever if negative), wake up to n sleepers. pshared
+ * must be set when the word lives in memory shared between processes,
+ * otherwise the cheaper private futexes are used.
+ */
+void	futex_wait(atomic_int *addr, int val, int pshared, long long timeout_us)
+{
+	struct timespec	ts;
+	struct timespec	*timeout;
+	int				op;
+
+	op = FUTEX_WAIT_PRIVATE;
+	if (pshared)
+		op = FUTEX_WAIT;
+	timeout = NULL;
+	if (timeout_us >= 0)
+	{
+		ts.tv_sec = timeout_us / 1000000;
+		ts.tv_nsec = (timeout_us % 1000000) * 1000;
+		timeout = &ts;
+	}
+	syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+void	futex_wake(atomic_int *addr, int n, int pshared)
+{
+	int	op;
+
+	op = FUTEX_WAKE_PRIVATE;
+	if (pshared)
+		op = FUTEX_WAKE;
+	syscall(SYS_futex, addr, op, n, NULL, NULL, 0);
+}
+
+#else
+
+/**
+ * No futexes here: waiting degrades to a yield, which is still correct for
+ * callers that re-check the word in a loop.
+ */
+void	futex_wait(atomic_int *addr, int val, int pshared, long long timeout_us)
+{
+	(void)pshared;
+	(void)timeout_us;
+	if (atomic_load(addr) == val)
+		sched_yield();
+}
+
+void	futex_wake(atomic_int *addr, int n, int pshared)
+{
+	(void)addr;
+	(void)n;
+	(void)pshared;
+}
+
+#endif
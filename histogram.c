@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   histogram.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:41:03 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 21:41:03 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Below 2^HIST_SUB_BITS every value has its own bucket. Past that a value
+ * with its top bit at position HIST_SUB_BITS - 1 + e is shifted right by e,
+ * leaving its HIST_SUB_BITS significant bits: the upper half of them picks
+ * one of the 2^(HIST_SUB_BITS - 1) buckets of exponent e.
+ * Negative values count as 0, those out of range in the last bucket.
+ */
+void	hist_record(t_hist *hist, long long value)
+{
+	int	e;
+	int	half;
+
+	half = 1 << (HIST_SUB_BITS - 1);
+	if (value < 0)
+		value = 0;
+	if (value >= (1LL << HIST_MAX_BITS))
+		value = (1LL << HIST_MAX_BITS) - 1;
+	if (value > hist->max)
+		hist->max = value;
+	hist->count++;
+	if (value < 2 * half)
+	{
+		hist->buckets[value]++;
+		return ;
+	}
+	e = 63 - __builtin_clzll(value) - (HIST_SUB_BITS - 1);
+	hist->buckets[2 * half + (e - 1) * half + (value >> e) - half]++;
+}
+
+void	hist_merge(t_hist *dst, const t_hist *src)
+{
+	int	i;
+
+	i = -1;
+	while (++i < HIST_BUCKETS)
+		dst->buckets[i] += src->buckets[i];
+	dst->count += src->count;
+	if (src->max > dst->max)
+		dst->max = src->max;
+}
+
+/**
+ * Return: the highest value of the bucket holding the q-th quantile (never
+ * more than the max recorded), 0 for an empty histogram.
+ */
+long long	hist_percentile(const t_hist *hist, double q)
+{
+	long long	rank;
+	long long	seen;
+	long long	top;
+	int			half;
+	int			i;
+
+	half = 1 << (HIST_SUB_BITS - 1);
+	rank = (long long)(q * hist->count + 0.999999);
+	if (rank < 1)
+		rank = 1;
+	seen = 0;
+	i = 0;
+	while (i < HIST_BUCKETS - 1 && seen + hist->buckets[i] < rank)
+		seen += hist->buckets[i++];
+	top = i;
+	if (i >= 2 * half)
+		top = ((long long)((i - 2 * half) % half + half + 1)
+				<< ((i - 2 * half) / half + 1)) - 1;
+	if (top > hist->max)
+		top = hist->max;
+	return (top);
+}
+
+void	hist_print(const char *what, const t_hist *hist)
+{
+	fprintf(stderr, "%s: count=%lld p50=%lld p99=%lld p99.9=%lld max=%lld\n",
+		what, hist->count, hist_percentile(hist, 0.5),
+		hist_percentile(hist, 0.99), hist_percentile(hist, 0.999), hist->max);
+}
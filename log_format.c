@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_format.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:09:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:00:16 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Writes the decimal digits of n at dst and returns how many they are.
+ * Digits are produced backwards in a small stack buffer, so there is no need
+ * to count them first nor to allocate (see ft_ulltoa for the malloc version).
+ */
+static size_t	put_ull(char *dst, unsigned long long n)
+{
+	char	tmp[20];
+	size_t	len;
+	size_t	i;
+
+	len = 0;
+	tmp[len++] = (n % 10) + '0';
+	while (n >= 10)
+	{
+		n /= 10;
+		tmp[len++] = (n % 10) + '0';
+	}
+	i = 0;
+	while (i < len)
+	{
+		dst[i] = tmp[len - 1 - i];
+		i++;
+	}
+	return (len);
+}
+
+const char	*activity_name(int activity)
+{
+	static const char	*names[] = {"has taken a fork", "is eating",
+		"is sleeping", "is thinking", "died"};
+
+	return (names[activity]);
+}
+
+/**
+ * Formats "<timestamp> <id> <msg>\n" at dst, which must have room for at
+ * least LOG_LINE_MAX bytes.
+ * Return: the length of the line (no terminating '\0' is written).
+ */
+size_t	format_line(char *dst, long long timestamp, int id, const char *msg)
+{
+	size_t	len;
+
+	len = put_ull(dst, (unsigned long long)timestamp);
+	dst[len++] = ' ';
+	len += put_ull(dst + len, (unsigned long long)id);
+	dst[len++] = ' ';
+	while (*msg)
+		dst[len++] = *msg++;
+	dst[len++] = '\n';
+	return (len);
+}
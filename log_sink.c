@@ -0,0 +1,71 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   log_sink.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:21:37 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 01:50:23 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * The buffer is sized for a full batch once and for all, so appending a line
+ * can never overflow nor allocate.
+ * Return: 1 on success, 0 if the allocation failed.
+ */
+int	sink_init(t_sink *sink, int fd, int batch, int flush_ms)
+{
+	sink->fd = fd;
+	sink->batch = batch;
+	sink->flush_ms = flush_ms;
+	sink->len = 0;
+	sink->lines = 0;
+	sink->last_flush = 0;
+	sink->buf = malloc((size_t)batch * LOG_LINE_MAX);
+	return (sink->buf != NULL);
+}
+
+/**
+ * Writes the whole pending batch. write(2) on a pipe may be partial, so we
+ * loop until everything is out (or the fd is gone). A sink on a negative fd
+ * just drops it.
+ */
+void	sink_flush(t_sink *sink)
+{
+	size_t	done;
+	ssize_t	ret;
+
+	done = 0;
+	while (sink->fd >= 0 && done < sink->len)
+	{
+		ret = write(sink->fd, sink->buf + done, sink->len - done);
+		if (ret <= 0)
+			break ;
+		done += ret;
+	}
+	sink->len = 0;
+	sink->lines = 0;
+}
+
+void	sink_line(t_sink *sink, long long timestamp, int id, const char *msg)
+{
+	sink->len += format_line(sink->buf + sink->len, timestamp, id, msg);
+	if (++sink->lines >= sink->batch)
+		sink_flush(sink);
+}
+
+/**
+ * Called periodically by the owner of the sink: lines never wait on screen
+ * more than flush_ms even when the batch is far from full.
+ */
+void	sink_tick(t_sink *sink, long long now)
+{
+	if (sink->len && now - sink->last_flush >= sink->flush_ms)
+		sink_flush(sink);
+	if (!sink->len)
+		sink->last_flush = now;
+}
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   opts.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:34:50 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Return: 0 if an option was given an unknown or out of range value, or
+ * two of them can not go together.
+ */
+static int	opts_valid(const t_opts *opts)
+{
+	if (opts->log_batch <= 0 || opts->log_flush_ms < 0
+		|| opts->clock_source < 0 || opts->fork_lock < 0
+		|| opts->strategy < 0 || opts->engine < 0 || opts->workers < 0
+		|| opts->run_for_ms < 0 || opts->grants < 0 || opts->format < 0
+		|| opts->placement < 0 || opts->spawn < 0 || opts->shards < 0
+		|| opts->fork_link < 0)
+		return (0);
+	if (opts->stack_kb && opts->stack_kb < MIN_STACK_KB)
+		return (0);
+	return (opts->engine != ENGINE_SHARDS || opts->grants != GRANTS_RECORD);
+}
+
+/**
+ * Parses the --name=value options that may precede the positional parameters
+ *  --log-batch=<n>: lines written with a single write(2) (default 64).
+ *  --log-flush-ms=<ms>: max time a line may wait in the batch (default 2).
+ *  --clock=mono|raw|tsc: time source of the simulation (default mono).
+ *  --fork-lock=pthread|ticket|mcs|adaptive: lock guarding each fork
+ *    (default pthread, ignored by the bonus where forks are a semaphore).
+ *  --strategy=parity|hierarchy|waiter|waiter-half|chandy-misra: how the
+ *    philos avoid deadlocks (default parity, ignored by the bonus).
+ *  --engine=threads|fibers|shards: one thread per philo (default), or the
+ *    philos as fibers scheduled on --workers=<n> threads (default: one per
+ *    cpu), or one thread per philo in --shards=<n> processes each running
+ *    a contiguous range of the table (default: one per cpu); fibers force
+ *    the adaptive fork lock, shards can not --record. Ignored by the bonus.
+ *  --fork-link=shm|socket: the forks between two shards are in shared
+ *    memory (default), or passed as request / grant messages on a
+ *    SOCK_SEQPACKET socket between the two shard processes. Ignored
+ *    without --engine=shards.
+ *  --placement=none|core|node: pin contiguous ranges of philos (of
+ *    workers with fibers) to one cpu each, or to the cpus of one numa node
+ *    each (default none: the os decides). Ignored by the bonus.
+ *  --stack-size=<KB>: stack of every philo thread or fiber, at least
+ *    MIN_STACK_KB (default 256 for threads, 64 for fibers). Ignored by the
+ *    bonus.
+ *  --virtual-time: simulated time, moved from one event to the next without
+ *    ever waiting (implies the fibers engine on a single worker).
+ *  --workload=<file>: the timings of every philo, or of ranges of them,
+ *    with their jitter (see workload_load); the positional parameters,
+ *    then optional, are the defaults.
+ *  --run-for=<ms>: stop the simulation after ms (of simulated time with
+ *    --virtual-time). Ignored by the bonus.
+ *  --record=<file>: save the order in which the forks were granted.
+ *  --replay=<file>: grant the forks in the order recorded in file.
+ *  --stats: print the simulation counters on stderr at exit.
+ *  --stats-file=<file>: keep the live counters of every philo in file, for
+ *    philo_stats to read while the simulation runs.
+ *  --histograms: print on stderr at exit the percentiles of the fork waits,
+ *    of the sleep overshoot and of the death report lag. Ignored by the
+ *    bonus.
+ *  --format=csv|json: how philo_bench prints its results (default csv).
+ *  --spawn=fork|tree: the bonus parent forks every philo itself (default),
+ *    or only the first, each philo forking the next ones down a binary
+ *    tree. Ignored by philo.
+ *
+ * Options not given are 0, which is also the first value (the default) of
+ * every enum.
+ * Return: the index in argv of the first positional parameter, -1 if an
+ * option is unknown or has an invalid value.
+ */
+int	parse_opts(int argc, char **argv, t_opts *opts)
+{
+	int	i;
+
+	memset(opts, 0, sizeof(t_opts));
+	opts->log_batch = DEFAULT_LOG_BATCH;
+	opts->log_flush_ms = DEFAULT_LOG_FLUSH_MS;
+	i = 1;
+	while (i < argc && argv[i][0] == '-' && argv[i][1] == '-')
+	{
+		if (!set_opt(opts, argv[i]))
+		{
+			printf("Invalid option: %s\n", argv[i]);
+			return (-1);
+		}
+		i++;
+	}
+	if (!opts_valid(opts))
+	{
+		printf("Invalid options.\n");
+		return (-1);
+	}
+	return (i);
+}
+
+/**
+ * Return: 0 unless there are at least two philos and every one of them
+ * (each of the workload, or all of them with cfg) has valid timings.
+ */
+static int	table_valid(const t_config *cfg, const t_workload *wl)
+{
+	int	i;
+
+	if (wl->n <= 1)
+		return (0);
+	if (!wl->timings)
+		return (timing_valid(cfg));
+	i = 0;
+	while (i < wl->n && timing_valid(&wl->timings[i]))
+		i++;
+	return (i == wl->n);
+}
+
+/**
+ * The table given after the options (argv[0] being the last of them, see
+ * parse_opts): N die eat sleep [meals], the timings every philo gets in
+ * cfg (zeroed by the caller), then the --workload file at wl->path if any,
+ * which may change them philo by philo (see workload_load). With a
+ * workload the positional parameters may be left out, as long as the file
+ * says it all. wl->n is the size of the table.
+ * Return: the number of philos, 0 (after saying why) if the parameters are
+ * not valid.
+ */
+int	table_params(int argc, char **argv, t_config *cfg, t_workload *wl)
+{
+	if ((argc != 1 || !wl->path) && (argc < 5 || argc > 6))
+	{
+		printf("Invalid number of arguments.\n");
+		return (0);
+	}
+	cfg->num_of_eating_times = -1;
+	if (argc == 6)
+		cfg->num_of_eating_times = ft_atoi(argv[5]);
+	if (argc > 1)
+	{
+		wl->n = ft_atoi(argv[1]);
+		cfg->time_to_die = ft_atoi(argv[2]);
+		cfg->time_to_eat = ft_atoi(argv[3]);
+		cfg->time_to_sleep = ft_atoi(argv[4]);
+	}
+	if (wl->path && !workload_load(wl->path, cfg, wl))
+		return (0);
+	if (!table_valid(cfg, wl))
+	{
+		printf("Invalid parameters.\n");
+		return (0);
+	}
+	return (wl->n);
+}
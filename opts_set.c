@@ -0,0 +1,122 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   opts_set.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:32:13 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:32:13 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * --record and --replay share the trace path, only one of them may be
+ * given.
+ */
+static int	set_trace_opt(t_opts *opts, char *arg)
+{
+	int	mode;
+
+	mode = GRANTS_OFF;
+	if (opt_value(arg, "record"))
+		mode = GRANTS_RECORD;
+	else if (opt_value(arg, "replay"))
+		mode = GRANTS_REPLAY;
+	if (mode == GRANTS_OFF)
+		return (0);
+	if (opts->grants != GRANTS_OFF)
+		opts->grants = -1;
+	else
+		opts->grants = mode;
+	opts->trace_path = opt_value(arg, "record");
+	if (mode == GRANTS_REPLAY)
+		opts->trace_path = opt_value(arg, "replay");
+	return (1);
+}
+
+/**
+ * What the run does besides the table: how long, with what timings, in
+ * which time, and what it reports (see parse_opts).
+ */
+static int	set_run_opt(t_opts *opts, char *arg)
+{
+	static const char	*formats[] = {"csv", "json", NULL};
+
+	if (opt_flag(arg, "virtual-time"))
+		opts->virtual_time = 1;
+	else if (opt_value(arg, "run-for"))
+		opts->run_for_ms = parse_num(opt_value(arg, "run-for"));
+	else if (opt_value(arg, "workload"))
+		opts->workload_path = opt_value(arg, "workload");
+	else if (opt_value(arg, "stats-file"))
+		opts->stats_path = opt_value(arg, "stats-file");
+	else if (opt_flag(arg, "stats"))
+		opts->stats = 1;
+	else if (opt_flag(arg, "histograms"))
+		opts->histograms = 1;
+	else if (opt_value(arg, "format"))
+		opts->format = opt_choice(opt_value(arg, "format"), formats);
+	else
+		return (set_trace_opt(opts, arg));
+	return (1);
+}
+
+/**
+ * How the philos are scheduled and where they run.
+ */
+static int	set_table_opt(t_opts *opts, char *arg)
+{
+	static const char	*strategies[] = {"parity", "hierarchy", "waiter",
+		"waiter-half", "chandy-misra", NULL};
+	static const char	*engines[] = {"threads", "fibers", "shards", NULL};
+	static const char	*placements[] = {"none", "core", "node", NULL};
+
+	if (opt_value(arg, "strategy"))
+		opts->strategy = opt_choice(opt_value(arg, "strategy"), strategies);
+	else if (opt_value(arg, "engine"))
+		opts->engine = opt_choice(opt_value(arg, "engine"), engines);
+	else if (opt_value(arg, "placement"))
+		opts->placement = opt_choice(opt_value(arg, "placement"), placements);
+	else if (opt_value(arg, "workers"))
+		opts->workers = parse_num(opt_value(arg, "workers"));
+	else if (opt_value(arg, "shards"))
+		opts->shards = parse_num(opt_value(arg, "shards"));
+	else if (opt_value(arg, "stack-size"))
+		opts->stack_kb = parse_num(opt_value(arg, "stack-size"));
+	else
+		return (set_run_opt(opts, arg));
+	return (1);
+}
+
+/**
+ * Sets in opts the --name=value (or --name) option arg (see parse_opts).
+ * Return: 0 if arg is not an option, an enum with an unknown value being
+ * left at -1 for parse_opts to reject.
+ */
+int	set_opt(t_opts *opts, char *arg)
+{
+	static const char	*clocks[] = {"mono", "raw", "tsc", NULL};
+	static const char	*locks[] = {"pthread", "ticket", "mcs", "adaptive",
+		NULL};
+	static const char	*spawns[] = {"fork", "tree", NULL};
+	static const char	*links[] = {"shm", "socket", NULL};
+
+	if (opt_value(arg, "log-batch"))
+		opts->log_batch = parse_num(opt_value(arg, "log-batch"));
+	else if (opt_value(arg, "log-flush-ms"))
+		opts->log_flush_ms = parse_num(opt_value(arg, "log-flush-ms"));
+	else if (opt_value(arg, "clock"))
+		opts->clock_source = opt_choice(opt_value(arg, "clock"), clocks);
+	else if (opt_value(arg, "fork-lock"))
+		opts->fork_lock = opt_choice(opt_value(arg, "fork-lock"), locks);
+	else if (opt_value(arg, "spawn"))
+		opts->spawn = opt_choice(opt_value(arg, "spawn"), spawns);
+	else if (opt_value(arg, "fork-link"))
+		opts->fork_link = opt_choice(opt_value(arg, "fork-link"), links);
+	else
+		return (set_table_opt(opts, arg));
+	return (1);
+}
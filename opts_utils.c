@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   opts_utils.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:21:36 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:59:53 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * If arg is "--<name>=<value>" returns a pointer to value, NULL otherwise.
+ */
+char	*opt_value(char *arg, const char *name)
+{
+	if (arg[0] != '-' || arg[1] != '-')
+		return (NULL);
+	arg += 2;
+	while (*name && *arg == *name)
+	{
+		arg++;
+		name++;
+	}
+	if (*name || *arg != '=')
+		return (NULL);
+	return (arg + 1);
+}
+
+/**
+ * Returns 1 if arg is exactly "--<name>".
+ */
+int	opt_flag(char *arg, const char *name)
+{
+	if (arg[0] != '-' || arg[1] != '-')
+		return (0);
+	arg += 2;
+	while (*name && *arg == *name)
+	{
+		arg++;
+		name++;
+	}
+	return (!*name && !*arg);
+}
+
+/**
+ * Returns the index of value in the NULL terminated list of names, -1 if it
+ * is not there.
+ */
+int	opt_choice(const char *value, const char **names)
+{
+	int			i;
+	const char	*a;
+	const char	*b;
+
+	i = -1;
+	while (names[++i])
+	{
+		a = value;
+		b = names[i];
+		while (*a && *a == *b)
+		{
+			a++;
+			b++;
+		}
+		if (!*a && !*b)
+			return (i);
+	}
+	return (-1);
+}
+
+/**
+ * The value of s if it is a decimal number (only digits, at most INT_MAX),
+ * -1 otherwise.
+ */
+long long	parse_num(const char *s)
+{
+	long long	v;
+
+	v = 0;
+	if (!*s)
+		return (-1);
+	while (*s >= '0' && *s <= '9' && v <= INT_MAX)
+		v = v * 10 + *s++ - '0';
+	if (*s || v > INT_MAX)
+		return (-1);
+	return (v);
+}
+
+/**
+ * The next word of *s (words being separated by blanks), terminated in
+ * place; *s moves past it. NULL once there are no more words.
+ */
+char	*next_token(char **s)
+{
+	char	*tok;
+
+	while (**s == ' ' || **s == '\t' || **s == '\r')
+		(*s)++;
+	if (!**s)
+		return (NULL);
+	tok = *s;
+	while (**s && **s != ' ' && **s != '\t' && **s != '\r')
+		(*s)++;
+	if (**s)
+		*(*s)++ = '\0';
+	return (tok);
+}
@@ -6,52 +6,566 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/22 23:34:10 by amarabin          #+#    #+#             */
-/*   Updated: 2023/09/22 23:34:11 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PHILO_H
 # define PHILO_H
 
+# include "philo_common.h"
 # include <limits.h>
 # include <pthread.h>
+# include <signal.h>
+# include <stdatomic.h>
+# include <stdint.h>
 # include <stdio.h>
 # include <stdlib.h>
+# include <string.h>
+# include <poll.h>
+# include <sys/mman.h>
+# include <sys/socket.h>
 # include <sys/time.h>
+# include <sys/wait.h>
+# include <ucontext.h>
 # include <unistd.h>
+# ifdef __linux__
+#  include <sys/prctl.h>
+# endif
 
+/*
+ * RING_SIZE must be a power of two: indexes are free running counters
+ * masked with RING_SIZE - 1.
+ */
+# define RING_SIZE 128
+# define LOG_POLL_US 500
+
+/*
+ * Spinning locks yield the cpu every LOCK_YIELD_SPINS turns, so that a
+ * waiter never burns a whole time slice of the holder it waits for; the
+ * adaptive lock spins ADAPTIVE_SPINS turns before parking on the futex.
+ */
+# define LOCK_YIELD_SPINS 64
+# define ADAPTIVE_SPINS 100
+
+/*
+ * Longest a philo waiting for a seat or a Chandy-Misra fork sleeps without
+ * looking at the state of the simulation.
+ */
+# define STRATEGY_POLL_US 1000
+
+/*
+ * Stack of every philo thread and of every fiber (unless --stack-size says
+ * otherwise), and number of buckets of the parking lot of the fibers engine
+ * (a fiber waiting on a word is queued in the bucket the word hashes to).
+ */
+# define THREAD_STACK 262144
+# define FIBER_STACK 65536
+# ifndef MAP_NORESERVE
+#  define MAP_NORESERVE 0
+# endif
+# define PARK_BUCKETS 4096
+
+/*
+ * With --fork-link=socket a message carries up to LINK_BATCH requests or
+ * grants, and the link thread looks at the state of the simulation at
+ * least every LINK_POLL_MS.
+ */
+# define LINK_BATCH 32
+# define LINK_POLL_MS 1
+
+/*
+ * Placement (--placement): cpus and numa nodes we know about.
+ */
+# define PLACE_MAX_CPUS 1024
+# define PLACE_MAX_NODES 64
+
+typedef struct s_event
+{
+	long long		timestamp;
+	int				id;
+	int				activity;
+}					t_event;
+
+typedef struct s_ring
+{
+	atomic_uint		head;
+	atomic_uint		tail;
+	t_event			events[RING_SIZE];
+}					t_ring;
+
+typedef struct s_heap_node
+{
+	long long		key;
+	int				idx;
+}					t_heap_node;
+
+typedef struct s_heap
+{
+	t_heap_node		*nodes;
+	int				size;
+}					t_heap;
+
+/*
+ * Queue node of the MCS lock: each waiter spins on its own node.
+ */
+typedef struct s_qnode
+{
+	struct s_qnode *_Atomic	next;
+	atomic_int				locked;
+}					t_qnode;
+
+/*
+ * Counters of a fork, only written by the thread holding it.
+ * spins are the busy-wait turns, parks the times a waiter went to sleep
+ * (a futex wait, or a blocking pthread_mutex_lock).
+ */
+typedef struct s_lock_stats
+{
+	long long		acquired;
+	long long		contended;
+	long long		spins;
+	long long		parks;
+	long long		cross_node;
+}					t_lock_stats;
+
+/*
+ * Grant order of a fork (--record, --replay): bit i of bits tells which of
+ * its two users (users[0] or users[1], philo ids) got the fork the i-th
+ * time; len grants are recorded, in cap bytes. turn counts the grants made
+ * so far, the philos waiting for theirs in replay sleep on it (and give up
+ * once active, the simulation_active flag, is cleared).
+ */
+typedef struct s_grants
+{
+	int				mode;
+	int				users[2];
+	unsigned char	*bits;
+	long long		len;
+	long long		cap;
+	atomic_int		turn;
+	atomic_int		*active;
+}					t_grants;
+
+/*
+ * A fork, guarded by the lock chosen with --fork-lock: the pthread mutex,
+ * a ticket lock (next_ticket/now_serving), an MCS queue lock (tail, holder
+ * being the node of the current owner) or the adaptive spin-then-park lock
+ * (state: 0 free, 1 taken, 2 taken with sleepers).
+ * With the Chandy-Misra strategy the lock only guards the fork's message
+ * state: the id of the philo owning it, whether it is dirty, in use (being
+ * eaten with) and the id of the neighbour requesting it (0 if none).
+ * Every fork starts on its own cache line (and its size is rounded to a
+ * whole number of lines): taking one never invalidates its neighbours.
+ * pshared is set on the forks between two shards (see shard_boundary):
+ * their mutex is a process shared, robust one, and their sleepers are
+ * woken across processes.
+ */
+typedef struct s_fork
+{
+	_Alignas(64) int	kind;
+	int				pshared;
+	pthread_mutex_t	mutex;
+	atomic_uint		next_ticket;
+	atomic_uint		now_serving;
+	t_qnode *_Atomic	tail;
+	t_qnode			*holder;
+	atomic_int		state;
+	t_lock_stats	stats;
+	int				owner;
+	int				dirty;
+	int				in_use;
+	int				req;
+	int				last_node;
+	t_grants		grants;
+	struct s_lfork	*remote;
+}					t_fork;
+
+typedef enum e_link_op_kind
+{
+	LINK_REQUEST,
+	LINK_GRANT
+}					t_link_op_kind;
+
+typedef struct s_link_op
+{
+	int				fork;
+	int				op;
+}					t_link_op;
+
+/*
+ * One SOCK_SEQPACKET message: n requests or grants.
+ */
+typedef struct s_link_msg
+{
+	int				n;
+	t_link_op		ops[LINK_BATCH];
+}					t_link_msg;
+
+/*
+ * What one end of a link (shard from, talking to shard to) sent and
+ * received, and the round trip of its requests: from the request sent to
+ * the grant received. Written by that shard only, read by the parent.
+ */
+typedef struct s_link_stats
+{
+	int				from;
+	int				to;
+	long long		requests;
+	long long		msgs_out;
+	long long		ops_out;
+	long long		msgs_in;
+	long long		ops_in;
+	t_hist			rtt;
+}					t_link_stats;
+
+/*
+ * The socket pair between two shards (shards[0] < shards[1]) and the
+ * forks between them. Each shard process has its own copy: side is the end
+ * it uses (-1 if the link is not its), lock and cond guard and signal its
+ * side of the forks, out is the message being batched.
+ */
+typedef struct s_link
+{
+	int				shards[2];
+	int				fds[2];
+	int				side;
+	pthread_mutex_t	lock;
+	pthread_cond_t	cond;
+	t_link_msg		out;
+	t_link_stats	*stats;
+}					t_link;
+
+/*
+ * A fork between two shards with --fork-link=socket: a token, owned by one
+ * side at a time (have). busy while a local philo eats with it, wanted
+ * when the other side asked for it meanwhile, requested while our request
+ * is on its way. owner is the shard holding it first. Private to each
+ * shard process, as its link.
+ */
+typedef struct s_lfork
+{
+	t_link			*link;
+	struct s_shared	*shared;
+	int				fork;
+	int				owner;
+	int				have;
+	int				busy;
+	int				wanted;
+	int				requested;
+	long long		sent_at;
+}					t_lfork;
+
+typedef struct s_philo	t_philo;
+
+/*
+ * The latencies --histograms records: the wait from "is thinking" to the
+ * first and to the second fork, the sleep overshoot, and how late "died"
+ * was printed past the deadline of the philo.
+ */
+typedef enum e_hist_kind
+{
+	HIST_FIRST_FORK,
+	HIST_SECOND_FORK,
+	HIST_OVERSHOOT,
+	HIST_DEATH_LAG,
+	HIST_KINDS
+}					t_hist_kind;
+typedef struct s_engine	t_engine;
+
+/*
+ * A philo run as a coroutine. next links it in whatever queue it is in: the
+ * run queue or inbox of its worker, or a parking lot bucket while it waits
+ * on wait_word.
+ */
+typedef struct s_fiber
+{
+	ucontext_t		ctx;
+	t_philo			*philo;
+	struct s_fiber	*next;
+	atomic_int		*wait_word;
+	int				worker;
+	int				done;
+}					t_fiber;
+
+/*
+ * A thread running fibers. run_head/run_tail and timers (the fibers asleep,
+ * by wake up time) are only touched by the worker itself, other workers
+ * hand it the fibers they wake up through inbox (a lock free stack) and
+ * ring bell to get it out of its idle wait.
+ */
+typedef struct s_worker
+{
+	pthread_t		thread;
+	ucontext_t		sched;
+	t_fiber			*current;
+	t_fiber			*run_head;
+	t_fiber			*run_tail;
+	t_fiber *_Atomic	inbox;
+	atomic_int		bell;
+	t_heap			timers;
+	t_engine		*engine;
+	struct s_shared	*shared;
+}					t_worker;
+
+typedef struct s_bucket
+{
+	atomic_flag		lock;
+	t_fiber			*head;
+	t_fiber			*tail;
+}					t_bucket;
+
+/*
+ * With the shards engine the philos run in n_shards processes (their pids
+ * in shards, only known to the parent), each one counting itself in
+ * shards_ready once all its threads exist. With --fork-link=socket the
+ * forks between them are passed along n_links links (see link_setup).
+ */
+struct s_engine
+{
+	pthread_t		monitor;
+	pthread_t		*threads;
+	t_fiber			*fibers;
+	t_worker		*workers;
+	int				n_workers;
+	char			*stacks;
+	size_t			stacks_len;
+	size_t			stack_size;
+	t_bucket		buckets[PARK_BUCKETS];
+	int				n_shards;
+	pid_t			*shards;
+	atomic_int		shards_ready;
+	t_link			*links;
+	t_lfork			*lforks;
+	t_link_stats	*link_stats;
+	int				n_links;
+};
+
+/*
+ * A deadlock avoidance scheme (--strategy).
+ * setup: picks, for every philo, the order of his forks (first_fork,
+ * second_fork) and whatever initial state the scheme needs.
+ * take: makes sure the philo holds his nth fork (0 or 1), blocking as long
+ * as needed.
+ * put: gives back whatever the philo holds (forks, seat), also when he
+ * leaves in the middle of taking them.
+ * stagger: even philos start by sleeping.
+ */
+typedef struct s_strategy
+{
+	int				stagger;
+	void			(*setup)(t_philo *p);
+	void			(*take)(t_philo *p, int nth);
+	void			(*put)(t_philo *p);
+}					t_strategy;
+
+/*
+ * The cpus we are allowed to run on, in order, the numa node of every cpu
+ * (0 when unknown) and the distinct nodes of those cpus, in order.
+ */
+typedef struct s_topology
+{
+	int				cpus[PLACE_MAX_CPUS];
+	int				node_of[PLACE_MAX_CPUS];
+	int				nodes[PLACE_MAX_NODES];
+	int				n_cpus;
+	int				n_nodes;
+}					t_topology;
+
+/*
+ * config holds the positional parameters, workload the --workload file
+ * (see table_params): every philo points to his own timings in one of
+ * them.
+ * rings holds one ring per philo (per worker with the fibers engine) plus,
+ * at index n_rings - 1, the one of the death monitor.
+ * died is the id of the philo who died (0 if none), ended_at the time the
+ * simulation was seen stopped.
+ * seat_tickets and seats are the waiter's queue: the tickets handed out
+ * so far, and how many of them are admitted at the table (see take_seat).
+ * hists (--histograms) holds HIST_KINDS histograms per recording thread:
+ * one set per philo thread or per worker, plus the log writer's, last.
+ * stats_file is the --stats-file mapping, NULL without it.
+ * arena is the single mapping holding the philos, the forks, the rings and
+ * the thread handles. With the shards engine the arena, the histograms and
+ * the t_shared itself (see shared_new) are shared with the shard
+ * processes. Nobody starts before started is set: spawn_start is when the
+ * threads started being created, t0 when they were all released (the time
+ * every philo had his last meal at) and first_event when the first of
+ * them got to run (-1 until then).
+ */
 typedef struct s_shared
 {
-	pthread_mutex_t	log_mutex;
-	pthread_mutex_t	simulation_mutex;
-	int				simulation_active;
+	t_config		config;
+	t_workload		workload;
+	atomic_int		simulation_active;
+	atomic_int		stop_claimed;
+	atomic_int		writer_stop;
+	int				died;
+	long long		ended_at;
+	pthread_mutex_t	end_mutex;
+	pthread_cond_t	end_cond;
+	int				ended;
+	t_philo			*philos;
+	int				n_philos;
+	t_fork			*forks;
+	t_strategy		strategy;
+	atomic_int		seat_tickets;
+	atomic_int		seats;
+	t_engine		engine;
+	t_ring			*rings;
+	int				n_rings;
+	t_heap			log_heap;
+	t_heap			monitor_heap;
+	t_sink			sink;
+	t_opts			opts;
+	t_clock			clock;
+	t_hist			*hists;
+	int				n_hists;
+	t_stats_head	*stats_file;
+	t_topology		topology;
+	char			*arena;
+	size_t			arena_len;
+	atomic_int		started;
+	long long		spawn_start;
+	long long		t0;
+	atomic_llong	first_event;
 }					t_shared;
 
-typedef struct s_philo
+/*
+ * A philo is laid out on cache lines by who writes them: the first ones
+ * are only written by the philo himself (his clock, his counters, next to
+ * the pointers he reads, set once, and the state of the generator his
+ * jitter is drawn from), the last one holds what other threads
+ * touch: deadline (read by the death monitor), doorbell (rung by the
+ * neighbours) and the MCS nodes (released by the previous holder). The
+ * table of philos being aligned as well, no two philos share a line.
+ */
+struct s_philo
 {
-	int				id;
-	int				time_to_die;
-	int				time_to_eat;
-	int				time_to_sleep;
-	int				num_of_eating_times;
+	_Alignas(64) long long	now;
 	long long		last_meal_time;
-	long long		time_slept;
+	int				id;
 	int				times_eaten;
-	pthread_mutex_t	*left_fork;
-	pthread_mutex_t	*right_fork;
+	int				held;
+	int				seated;
+	long long		max_hunger;
+	long long		fork_wait;
+	unsigned long long	rng;
+	const t_config	*config;
+	t_fork			*left_fork;
+	t_fork			*right_fork;
+	t_fork			*first_fork;
+	t_fork			*second_fork;
+	t_ring			*ring;
 	t_shared		*shared_resources;
-}					t_philo;
+	t_hist			*hists;
+	t_stats_slot	*stats_slot;
+	t_sleep_stats	sleep_stats;
+	_Alignas(64) atomic_llong	deadline;
+	atomic_int		doorbell;
+	t_qnode			qnodes[2];
+};
 
-int					ft_atoi(char *nptr);
-long long			get_timestamp(void);
-size_t				ft_strlen(const char *s);
-char				*ft_ulltoa(unsigned long long n);
 void				*philo_cycle(void *arg);
-void				verify_death(t_philo *philo, pthread_mutex_t *fork1,
-						pthread_mutex_t *fork2);
-void				log_activity(t_philo *philo, const char *activity,
-						pthread_mutex_t *fork1, pthread_mutex_t *fork2);
-void				verify_simulation_status(t_philo *philo,
-						pthread_mutex_t *fork1, pthread_mutex_t *fork2);
+void				verify_death(t_philo *philo);
+long long			sleep_margin(t_philo *p, long long left,
+						long long chk_int);
+void				log_activity(t_philo *philo, int activity);
+void				verify_simulation_status(t_philo *philo);
+void				philo_think(t_philo *p);
+void				fork_init(t_fork *fork, int kind, int pshared);
+void				fork_destroy(t_fork *fork);
+void				fork_lock(t_fork *fork, t_qnode *node, int id);
+void				fork_unlock(t_fork *fork);
+int					fork_mutex_lock(t_fork *fork, t_qnode *node);
+void				fork_mutex_unlock(t_fork *fork);
+int					fork_adaptive_lock(t_fork *fork, t_qnode *node);
+void				fork_adaptive_unlock(t_fork *fork);
+int					fork_ticket_lock(t_fork *fork, t_qnode *node);
+void				fork_ticket_unlock(t_fork *fork);
+int					fork_mcs_lock(t_fork *fork, t_qnode *node);
+void				fork_mcs_unlock(t_fork *fork);
+void				strategy_init(t_shared *shared);
+int					grants_init(t_shared *shared);
+void				grants_wait(t_fork *fork, int id);
+void				grants_take(t_fork *fork, int id);
+int					grants_load(t_shared *shared);
+int					grants_save(t_shared *shared);
+void				take_locked(t_philo *p, int nth);
+void				take_seated(t_philo *p, int nth);
+void				put_locked(t_philo *p);
+void				setup_cm(t_philo *p);
+void				take_cm(t_philo *p, int nth);
+void				put_cm(t_philo *p);
+t_shared			*shared_new(void);
+void				shared_free(t_shared *shared);
+int					init_state(t_shared *shared);
+int					simulation_running(t_shared *shared);
+void				stop_simulation(t_shared *shared, t_ring *ring,
+						long long now, int id);
+int					wait_end(t_shared *shared, long long deadline);
+void				ring_push(t_ring *ring, long long timestamp, int id,
+						int activity);
+void				*log_writer(void *arg);
+void				report_stats(t_shared *shared);
+int					histograms_init(t_shared *shared);
+void				placement_init(t_shared *shared);
+void				placement_attr(t_shared *shared, pthread_attr_t *attr,
+						int idx, int total);
+void				placement_bind(t_shared *shared, void *base, size_t size,
+						int n);
+void				placement_handoff(t_philo *p);
+int					stats_file_init(t_shared *shared);
+void				stats_publish(t_philo *p, int activity);
+void				histograms_report(t_shared *shared);
+const char			*opts_names(t_opts *opts, int which);
+int					init_log(t_shared *shared, int number_of_philosophers,
+						int fd);
+int					init_arena(t_shared *shared, int n);
+int					init_philos(t_shared *shared_resources);
+int					sim_setup(t_shared *shared, int n, int fd);
+int					sim_run(t_shared *shared);
+void				sim_teardown(t_shared *shared);
+t_worker			**current_worker(void);
+void				engine_sleep_until(t_philo *p, long long deadline);
+void				engine_exit(t_philo *p);
+void				engine_configure(t_shared *shared, int n_philos);
+void				park_wait(atomic_int *word, int val, int pshared,
+						long long timeout_us);
+void				park_wake(atomic_int *word, int n, int pshared);
+void				fiber_ready(t_engine *engine, t_fiber *fiber);
+void				run_push(t_worker *worker, t_fiber *fiber);
+t_fiber				*run_pop(t_worker *worker);
+void				take_inbox(t_worker *worker);
+void				*worker_main(void *arg);
+int					fibers_init(t_shared *shared);
+int					fibers_start(t_shared *shared);
+void				fibers_stop(t_shared *shared);
+int					engine_start(t_shared *shared);
+int					engine_go(t_shared *shared);
+int					start_threads(t_shared *shared, int from, int to);
+void				engine_wait_start(t_shared *shared);
+void				engine_stop(t_shared *shared);
+void				*table_map(t_shared *shared, size_t len);
+int					shard_of(t_shared *shared, int philo);
+int					shard_boundary(t_shared *shared, int fork);
+int					link_setup(t_shared *shared);
+int					link_attach(t_shared *shared, int s, pthread_t *thread);
+int					link_take(t_fork *fork);
+void				link_put(t_fork *fork);
+void				link_push(t_link *link, int fork, int op);
+void				link_flush(t_link *link);
+void				*link_thread(void *arg);
+void				link_report(t_shared *shared, long long elapsed);
+int					shards_start(t_shared *shared);
+int					shards_wait(t_shared *shared);
+void				shards_stop(t_shared *shared);
+void				*death_monitor(void *arg);
+void				monitor_init(t_shared *shared);
+long long			monitor_check(t_shared *shared, long long now);
+void				virtual_advance(t_shared *shared, long long next);
+void				heap_push(t_heap *heap, long long key, int idx);
+void				heap_pop(t_heap *heap);
+void				heap_sift_down(t_heap *heap, int i);
 
 #endif
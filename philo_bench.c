@@ -0,0 +1,150 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_bench.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:09:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:16:25 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bench.h"
+
+/**
+ * Cpu time of the process and of its children reaped so far (the shard
+ * processes, once a run is over).
+ */
+static long long	cpu_us(void)
+{
+	struct rusage	self;
+	struct rusage	children;
+
+	getrusage(RUSAGE_SELF, &self);
+	getrusage(RUSAGE_CHILDREN, &children);
+	return ((self.ru_utime.tv_sec + self.ru_stime.tv_sec
+			+ children.ru_utime.tv_sec + children.ru_stime.tv_sec) * 1000000LL
+		+ self.ru_utime.tv_usec + self.ru_stime.tv_usec
+		+ children.ru_utime.tv_usec + children.ru_stime.tv_usec);
+}
+
+/**
+ * Runs one scenario in process, its log discarded, for --run-for ms (with
+ * no meal count, the run ends there or on the first death) and prints its
+ * row. The cpu time is the one of the whole process over setup, run and
+ * teardown: every thread of the simulation, the log writer and the shard
+ * processes included.
+ * With --histograms the percentiles of the run follow on stderr.
+ */
+static int	bench_one(t_opts *opts, t_scenario *sc, int row)
+{
+	t_shared	*shared;
+	long long	cpu;
+
+	shared = shared_new();
+	if (!shared)
+		return (0);
+	shared->opts = *opts;
+	shared->config = (t_config){sc->die, sc->eat, sc->sleep, -1, 0, 0};
+	if (sc->workload)
+		shared->workload = *sc->workload;
+	cpu = cpu_us();
+	if (sc->n <= 1 || !sim_setup(shared, sc->n, -1)
+		|| !sim_run(shared))
+	{
+		fprintf(stderr, "Could not run %d:%d:%d:%d\n", sc->n, sc->die,
+			sc->eat, sc->sleep);
+		shared_free(shared);
+		return (0);
+	}
+	bench_row(shared, sc, cpu_us() - cpu, row);
+	histograms_report(shared);
+	sim_teardown(shared);
+	shared_free(shared);
+	return (1);
+}
+
+/**
+ * Runs every combination of the lists of a scenario (see bench_parse), the
+ * last field moving fastest.
+ * Return: the number of rows printed so far, -1 on error.
+ */
+static int	bench_matrix(t_opts *opts, char *arg, int row)
+{
+	t_matrix	m;
+	int			idx[4];
+	int			k;
+	t_scenario	sc;
+
+	sc.workload = NULL;
+	bench_parse(arg, &m);
+	memset(idx, 0, sizeof(idx));
+	k = 3;
+	while (k >= 0)
+	{
+		sc.n = m.vals[0][idx[0]];
+		sc.die = m.vals[1][idx[1]];
+		sc.eat = m.vals[2][idx[2]];
+		sc.sleep = m.vals[3][idx[3]];
+		if (!bench_one(opts, &sc, row++))
+			return (-1);
+		k = 3;
+		while (k >= 0 && ++idx[k] == m.len[k])
+			idx[k--] = 0;
+	}
+	return (row);
+}
+
+/**
+ * The --workload file (see bench_load) run as a single row, before the
+ * matrix.
+ * Return: the number of rows printed, -1 on error.
+ */
+static int	bench_workload(t_opts *opts, t_workload *wl, int row)
+{
+	t_scenario	sc;
+
+	sc.n = wl->n;
+	sc.die = wl->timings[0].time_to_die;
+	sc.eat = wl->timings[0].time_to_eat;
+	sc.sleep = wl->timings[0].time_to_sleep;
+	sc.workload = wl;
+	if (!bench_one(opts, &sc, row++))
+		row = -1;
+	free(wl->timings);
+	return (row);
+}
+
+/**
+ * Benchmark of the simulation, in place of watching philo run:
+ *  philo_bench [options] N:die:eat:sleep...
+ * takes the options of philo (--run-for is the length of every run,
+ * default 1s) and prints one row per scenario (see bench_row), as csv or
+ * json (--format). With --workload the file is run first, on its own row,
+ * the scenarios then being optional. The scenarios and the file are all
+ * checked before the first row: an invalid one leaves no half written
+ * document on stdout.
+ */
+int	main(int argc, char **argv)
+{
+	t_opts		opts;
+	t_workload	wl;
+	int			first;
+	int			row;
+
+	first = parse_opts(argc, argv, &opts);
+	if (first < 0 || !bench_check(argc, argv, first, &opts)
+		|| !bench_load(&opts, argv + first - 1, &wl))
+		return (1);
+	if (!opts.run_for_ms)
+		opts.run_for_ms = BENCH_DEFAULT_MS;
+	bench_begin(&opts);
+	row = 0;
+	if (opts.workload_path)
+		row = bench_workload(&opts, &wl, row);
+	while (first < argc && row >= 0)
+		row = bench_matrix(&opts, argv[first++], row);
+	bench_end(&opts);
+	return (row < 0);
+}
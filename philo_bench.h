@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_bench.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:06:40 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PHILO_BENCH_H
+# define PHILO_BENCH_H
+
+# include "philo.h"
+# include <sys/resource.h>
+
+# define BENCH_DEFAULT_MS 1000
+# define BENCH_MAX_VALUES 16
+
+/*
+ * One point of the matrix: the positional parameters of philo. For the
+ * --workload row, workload holds the timings of every philo (die, eat and
+ * sleep being those of philo 1), it is NULL otherwise.
+ */
+typedef struct s_scenario
+{
+	int				n;
+	int				die;
+	int				eat;
+	int				sleep;
+	t_workload		*workload;
+}					t_scenario;
+
+/*
+ * A scenario as given, before it is run: field k (N, die, eat, sleep) holds
+ * the len[k] values in vals[k].
+ */
+typedef struct s_matrix
+{
+	int				vals[4][BENCH_MAX_VALUES];
+	int				len[4];
+}					t_matrix;
+
+/*
+ * What a run leaves behind, summed over the philos (sum_sq is the sum of
+ * the squared meal counts, for Jain's index, min_margin the closest any
+ * philo came to his own time_to_die, elapsed how long the run lasted, in
+ * us, and jain the fairness of the meals).
+ */
+typedef struct s_bench_row
+{
+	long long		meals;
+	double			sum_sq;
+	int				min_meals;
+	int				max_meals;
+	long long		min_margin;
+	long long		elapsed;
+	double			jain;
+}					t_bench_row;
+
+int					bench_parse(char *arg, t_matrix *m);
+int					bench_check(int argc, char **argv, int first,
+						t_opts *opts);
+int					bench_load(t_opts *opts, char **argv, t_workload *wl);
+void				bench_collect(t_shared *shared, t_bench_row *r);
+void				bench_begin(t_opts *opts);
+void				bench_row(t_shared *shared, t_scenario *sc,
+						long long cpu_us, int row);
+void				bench_end(t_opts *opts);
+
+#endif
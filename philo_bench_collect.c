@@ -0,0 +1,69 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_bench_collect.c                              :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:33:49 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:33:49 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bench.h"
+
+/**
+ * Jain's fairness index of the meal counts, (sum x)^2 / (n sum x^2): 1 when
+ * every philo ate as much, 1/n when a single one did (0 if nobody ate).
+ */
+static double	jain(t_bench_row *r, int n)
+{
+	if (!r->meals)
+		return (0);
+	return ((double)r->meals * r->meals / (n * r->sum_sq));
+}
+
+/**
+ * Adds philo p to the row. The hunger of a philo is the longest he waited
+ * between two meals, or since his last one when the run stopped; his
+ * margin is what it left of his own time_to_die (a --workload gives each
+ * philo his own), and the row keeps the smallest.
+ */
+static void	add_philo(t_shared *shared, t_philo *p, t_bench_row *r)
+{
+	long long	hunger;
+	int			meals;
+
+	meals = p->times_eaten;
+	r->meals += meals;
+	r->sum_sq += (double)meals * meals;
+	if (meals < r->min_meals)
+		r->min_meals = meals;
+	if (meals > r->max_meals)
+		r->max_meals = meals;
+	hunger = p->max_hunger;
+	if (shared->ended_at - p->last_meal_time > hunger)
+		hunger = shared->ended_at - p->last_meal_time;
+	if (p->config->time_to_die * 1000LL - hunger < r->min_margin)
+		r->min_margin = p->config->time_to_die * 1000LL - hunger;
+}
+
+/**
+ * Sums the counters of the philos into r, with how long the run lasted
+ * (at least 1us, it divides) and the fairness of the meals.
+ */
+void	bench_collect(t_shared *shared, t_bench_row *r)
+{
+	int	i;
+
+	memset(r, 0, sizeof(t_bench_row));
+	r->min_meals = INT_MAX;
+	r->min_margin = LLONG_MAX;
+	i = -1;
+	while (++i < shared->n_philos)
+		add_philo(shared, &shared->philos[i], r);
+	r->elapsed = shared->ended_at - shared->t0;
+	if (r->elapsed < 1)
+		r->elapsed = 1;
+	r->jain = jain(r, shared->n_philos);
+}
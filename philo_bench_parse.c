@@ -0,0 +1,110 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_bench_parse.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:14:10 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:14:10 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bench.h"
+
+/**
+ * Reads a comma separated list of numbers, up to the next ':' (left in s).
+ * Return: how many were read, 0 if the list is empty or malformed.
+ */
+static int	parse_list(char **s, int *vals)
+{
+	int	n;
+
+	n = 0;
+	while (n < BENCH_MAX_VALUES && **s >= '0' && **s <= '9')
+	{
+		vals[n] = 0;
+		while (**s >= '0' && **s <= '9' && vals[n] < 100000000)
+			vals[n] = vals[n] * 10 + *(*s)++ - '0';
+		if (vals[n++] <= 0 || (**s != ',' && **s != ':' && **s))
+			return (0);
+		if (**s != ',')
+			return (n);
+		(*s)++;
+	}
+	return (0);
+}
+
+/**
+ * A scenario is N:die:eat:sleep where every field may be a list (e.g.
+ * 5,200:800:200:200,300), read in m. A table needs at least two philos.
+ * Return: 0 if the scenario is malformed.
+ */
+int	bench_parse(char *arg, t_matrix *m)
+{
+	int	k;
+	int	i;
+
+	k = -1;
+	while (++k < 4)
+	{
+		m->len[k] = parse_list(&arg, m->vals[k]);
+		if (!m->len[k] || (k < 3 && *arg++ != ':') || (k == 3 && *arg))
+			return (0);
+	}
+	i = -1;
+	while (++i < m->len[0])
+		if (m->vals[0][i] <= 1)
+			return (0);
+	return (1);
+}
+
+/**
+ * Checks every scenario, from argv[first] on, before any is run: there has
+ * to be one, but with --workload.
+ * Return: 0 (after saying why) if there is none or one is malformed.
+ */
+int	bench_check(int argc, char **argv, int first, t_opts *opts)
+{
+	t_matrix	m;
+
+	if (first >= argc && !opts->workload_path)
+	{
+		printf("Usage: %s [options] N:die:eat:sleep...\n", argv[0]);
+		return (0);
+	}
+	while (first < argc)
+	{
+		if (!bench_parse(argv[first], &m))
+		{
+			fprintf(stderr, "Invalid scenario: %s\n", argv[first]);
+			return (0);
+		}
+		first++;
+	}
+	return (1);
+}
+
+/**
+ * Loads the --workload file, if any, in wl: the file has to say it all,
+ * there are no positional parameters to default to (see table_params).
+ * argv[0] is the last of the options.
+ * Return: 0 if the file is not valid.
+ */
+int	bench_load(t_opts *opts, char **argv, t_workload *wl)
+{
+	t_config	defaults;
+
+	memset(wl, 0, sizeof(t_workload));
+	if (!opts->workload_path)
+		return (1);
+	memset(&defaults, 0, sizeof(t_config));
+	wl->path = opts->workload_path;
+	if (!table_params(1, argv, &defaults, wl))
+		return (0);
+	if (wl->n > 1)
+		return (1);
+	fprintf(stderr, "Invalid scenario: %s\n", wl->path);
+	free(wl->timings);
+	return (0);
+}
@@ -0,0 +1,85 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_bench_report.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:17:55 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bench.h"
+
+void	bench_begin(t_opts *opts)
+{
+	if (opts->format == FORMAT_JSON)
+		printf("[");
+	else
+		printf("n,time_to_die,time_to_eat,time_to_sleep,strategy,fork_lock,"
+			"engine,elapsed_ms,meals,meals_per_sec,min_meals,max_meals,jain,"
+			"min_margin_us,died,cpu_ms,startup_us,meals_per_philo\n");
+}
+
+/**
+ * The last column of a row, closing it.
+ */
+static void	meals_per_philo(t_shared *shared)
+{
+	static const char	*sep[] = {";", ","};
+	int					i;
+
+	i = -1;
+	while (++i < shared->n_philos)
+		printf("%s%d", sep[shared->opts.format] + (i == 0),
+			shared->philos[i].times_eaten);
+	if (shared->opts.format == FORMAT_JSON)
+		printf("]}");
+	else
+		printf("\n");
+}
+
+/**
+ * One row per run, with the same columns in csv and json:
+ *  elapsed_ms: how long the run lasted (simulated time with --virtual-time),
+ *    over which meals_per_sec is computed.
+ *  jain: Jain's fairness index of the meal counts (see jain).
+ *  min_margin_us: the smallest, over the philos, of time_to_die minus the
+ *    longest one went hungry (see add_philo), what was left of the closest
+ *    call (0 or less once one died).
+ *  died: the id of the philo who died, 0 if none did.
+ *  startup_us: from the creation of the first thread to the first philo
+ *    running (all the threads are created before any philo runs).
+ *  meals_per_philo: the meal count of each philo, in id order (';'
+ *    separated in csv).
+ */
+void	bench_row(t_shared *shared, t_scenario *sc, long long cpu_us, int row)
+{
+	static const char	*fmt[] = {"%d,%d,%d,%d,%s,%s,%s,%.3f,%lld,%.1f,%d,"
+		"%d,%.4f,%lld,%d,%.3f,%lld,", "\n{\"n\":%d,\"time_to_die\":%d,"
+		"\"time_to_eat\":%d,\"time_to_sleep\":%d,\"strategy\":\"%s\","
+		"\"fork_lock\":\"%s\",\"engine\":\"%s\",\"elapsed_ms\":%.3f,"
+		"\"meals\":%lld,\"meals_per_sec\":%.1f,\"min_meals\":%d,"
+		"\"max_meals\":%d,\"jain\":%.4f,\"min_margin_us\":%lld,\"died\":%d,"
+		"\"cpu_ms\":%.3f,\"startup_us\":%lld,\"meals_per_philo\":["};
+	t_bench_row			r;
+
+	bench_collect(shared, &r);
+	if (shared->opts.format == FORMAT_JSON && row > 0)
+		printf(",");
+	printf(fmt[shared->opts.format], sc->n, sc->die, sc->eat, sc->sleep,
+		opts_names(&shared->opts, 0), opts_names(&shared->opts, 1),
+		opts_names(&shared->opts, 2), r.elapsed / 1e3, r.meals,
+		r.meals * 1e6 / r.elapsed, r.min_meals, r.max_meals, r.jain,
+		r.min_margin, shared->died, cpu_us / 1e3,
+		atomic_load(&shared->first_event) - shared->spawn_start);
+	meals_per_philo(shared);
+	fflush(stdout);
+}
+
+void	bench_end(t_opts *opts)
+{
+	if (opts->format == FORMAT_JSON)
+		printf("\n]\n");
+}
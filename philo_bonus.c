@@ -6,7 +6,7 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/18 00:44:57 by amarabin          #+#    #+#             */
-/*   Updated: 2023/11/21 05:12:07 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:11:27 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,33 +15,31 @@
 /**
  * kill() sends a signal to a process. In this case is being used to make sure
  * that processes did actually terminate.
- * waitpid() does the final check waiting for the process to terminate and
- * Both these functions will return -1 if was impossible to reach the process
- * specified in the pid
- * this is fine since child processes are not allocating memory on their own.
+ * waitpid() does the final check waiting for the process to terminate: we
+ * reap any child until there is none left, the philos forked by other
+ * philos included (see adopt_orphans).
+ * The pid of a philo that never registered is 0, and is skipped.
+ * Only then the log writer is stopped: no child is left to log, every
+ * line they published gets printed (see log_writer).
  * It's also worth to mention that if the parent process itself terminates, all
  * its child processes are adopted by the "init" process which automatically
  * waits on its child processes, thereby preventing them from becoming zombies.
  */
-static void	cleanup(int number_of_philosophers, t_philo *philos,
-		t_sem semaphores, pid_t *child_pids)
+static void	cleanup(t_philo *f_tmpl)
 {
-	int	i;
+	t_shm	*shm;
+	int		i;
 
+	shm = f_tmpl->shm;
 	i = 0;
-	while (number_of_philosophers > i++)
-	{
-		kill(child_pids[i - 1], SIGKILL);
-		waitpid(child_pids[i - 1], NULL, 0);
-	}
-	free(child_pids);
-	sem_close(semaphores.fork_pool);
-	sem_close(semaphores.log_sem);
-	sem_close(semaphores.simulation_sem);
-	sem_unlink("log_sem");
-	sem_unlink("sim_sem");
-	sem_unlink("fork_pool");
-	free(philos);
+	while (shm->n > i++)
+		if (shm->seats[i - 1].pid > 0)
+			kill(shm->seats[i - 1].pid, SIGKILL);
+	while (waitpid(-1, NULL, 0) > 0)
+		;
+	log_stop(f_tmpl);
+	sem_destroy(&shm->fork_pool);
+	munmap(shm, shm_size(shm->n));
 }
 
 /**
@@ -52,166 +50,128 @@ static void	cleanup(int number_of_philosophers, t_philo *philos,
  * @f_tmpl: Pointer to a t_philo template used to populate other philo objects.
  * @number_of_philosophers: Will store the number of philosophers.
  *
- * The function expects at least 5 and at most 6 command-line arguments.
+ * The positional parameters may be preceded by --name=value options (see
+ * parse_opts), once those are skipped the function expects at least 5 and
+ * at most 6 command-line arguments (none at all being fine with a
+ * --workload, see table_params).
  *  1st argument: Number of philosophers.
  *  2nd argument: Time for a philosopher to die.
  *  3rd argument: Time for a philosopher to eat.
  *  4th argument: Time for a philosopher to sleep.
  *  5th argument (optional): Number of times a philo has to eat to end the app.
  *
+ * The clock is set up here, before any fork, so that every child inherits
+ * the same origin, as is the shared mapping of the pool trace.
  * Return: 1 if parameters are valid, 0 otherwise.
  */
 static int	validate_params(int argc, char **argv, t_philo *f_tmpl,
 		int *number_of_philosophers)
 {
-	if (argc < 5 || argc > 6)
-	{
-		printf("Invalid number of arguments.\n");
+	int	first;
+
+	first = parse_opts(argc, argv, &f_tmpl->opts);
+	if (first < 0)
 		return (0);
-	}
-	f_tmpl->time_to_die = ft_atoi(argv[2]);
-	f_tmpl->time_to_eat = ft_atoi(argv[3]);
-	f_tmpl->time_to_sleep = ft_atoi(argv[4]);
-	f_tmpl->num_of_eating_times = -1;
-	if (argc == 6)
-		f_tmpl->num_of_eating_times = ft_atoi(argv[5]);
-	*number_of_philosophers = ft_atoi(argv[1]);
-	if ((f_tmpl->num_of_eating_times < -1 || f_tmpl->num_of_eating_times == 0)
-		|| f_tmpl->time_to_die <= 0 || f_tmpl->time_to_eat <= 0
-		|| f_tmpl->time_to_sleep <= 0 || *number_of_philosophers <= 1)
-	{
-		printf("Invalid parameters.\n");
+	f_tmpl->workload.path = f_tmpl->opts.workload_path;
+	*number_of_philosophers = table_params(argc - first + 1,
+			argv + first - 1, &f_tmpl->config, &f_tmpl->workload);
+	if (!*number_of_philosophers)
 		return (0);
-	}
-	return (1);
+	clock_setup(&f_tmpl->clock, f_tmpl->opts.clock_source);
+	return (pool_trace_init(f_tmpl, *number_of_philosophers)
+		&& stats_file_init(f_tmpl, *number_of_philosophers));
 }
 
 /**
  * Relevant Elements/Functions:
  *
- * Using Named semaphores in a multiprocess environment:
- * Differently from a a regular semaphore (sem_init(<&sem_id>, 0, <n>>);)
- * that would work intraproc, named semaphores works interproc, creating
- * an absolute reference at the OS level.
- * This is why we use
- * sem_unlink("<sem_name>");
- * to prevent the situation where the main process might have been
- * interrupted abruptly leaving the sems hanging uncontrolled.
- * sem_open("<sem_name>", O_CREAT, 0644, <n>);
- * Initialize a semaphore to a value n > 0, specifying that we are
- * creating it (O_CREAT, flag has no effect if the semaphore already exixts),
- * permissions (0644: following Unix permissions model, means that the owner
- * has read and write permissions (rw-r--r--), while children can sem_wait or
- * sem_post only.
- * This means that the child will be able to access the semaphore using
- * sem_t *sem = sem_open("<sem_name>", 0);
- * (0 is a flag that means "open an existing semaphore with no options")
+ * Using a process shared semaphore in a multiprocess environment:
+ * a regular semaphore (sem_init(<&sem_id>, <pshared>, <n>);) works
+ * interproc as well as long as pshared is not 0 and the semaphore itself
+ * lives in memory every process sees: here a MAP_SHARED | MAP_ANONYMOUS
+ * mapping (see s_shm), made before any fork, that each child inherits as it
+ * is. Unlike named semaphores (sem_open("<sem_name>", O_CREAT, 0644, <n>))
+ * there is no name at the OS level: no file to create, nothing for the
+ * children to re-open, nothing to sem_unlink, and nothing left hanging if
+ * the main process is interrupted abruptly, the mapping goes with the last
+ * process using it.
+ * The philos are all copies of f_tmpl, which gets the mapping.
  */
-static t_philo	*init_philos(int n_of_philos, t_philo f_tmpl, t_sem *sems)
+static int	init_shm(int n_of_philos, t_philo *f_tmpl)
 {
-	int		i;
-	t_philo	*philos;
+	t_shm		*shm;
+	t_config	*cfg;
+	int			i;
 
-	sem_unlink("log_sem");
-	sem_unlink("sim_sem");
-	sem_unlink("fork_pool");
-	sems->log_sem = sem_open("log_sem", O_CREAT, 0644, 1);
-	sems->simulation_sem = sem_open("sim_sem", O_CREAT, 0644, n_of_philos);
-	sems->fork_pool = sem_open("fork_pool", O_CREAT, 0644, n_of_philos);
-	philos = malloc(n_of_philos * sizeof(t_philo));
-	if (!philos)
-		return (NULL);
-	i = 0;
-	while (n_of_philos > i++)
+	shm = mmap(NULL, shm_size(n_of_philos), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shm == MAP_FAILED)
+		return (0);
+	shm->n = n_of_philos;
+	i = -1;
+	while (++i < n_of_philos)
 	{
-		philos[i - 1] = f_tmpl;
-		philos[i - 1].id = i;
+		cfg = &f_tmpl->config;
+		if (f_tmpl->workload.timings)
+			cfg = &f_tmpl->workload.timings[i];
+		shm->targets += cfg->num_of_eating_times != -1;
 	}
-	return (philos);
+	atomic_init(&shm->unfed, shm->targets);
+	f_tmpl->shm = shm;
+	return (!sem_init(&shm->fork_pool, 1, n_of_philos));
 }
 
 /**
- * Creates threads for each philosopher and then detach them.
- * Each philosopher's lifecycle is managed in the `philo_cycle` function.
- * Relevant Elements/Functions:
- * Fork(): creates (spawns) a new process
- * When you call fork(), it creates a new process that is an almost exact copy
- * of the current process. Both the parent and the child continue executing
- * from the point where fork() was called. The only difference is the value
- * returned by fork():
- * In the parent process, fork() returns the child's Process ID (PID),
- * which is a positive integer. In the child process, fork() returns 0.
- * So when you check if (child_pids[i] == 0), you're essentially asking,
- * "Am I the child process?" If the answer is yes, you proceed to run the
- * philo_cycle function and then exit(0) to terminate cleanly.
- * Conversely, else if (child_pids[i] < 0) checks if the fork() failed to
- * create a new process. In such cases, fork() returns a negative value.
- * Therefore, this condition is for error-handling (thus we try to kill
- * any process created up to that point)
- * To summarize:
- * if (child_pids[i] == 0): This block is executed by the child process.
- * else if (child_pids[i] < 0): This block is executed by the parent if fork()
- * fails.
- * Once spawn each child process gets its own copy of the process memory,
- * including the philos array (thus being able to access the value passed to
- * the fn philo_cycle
+ * Creates a process for each philosopher (see spawn_philos), each one's
+ * lifecycle being managed in the `philo_cycle` function.
  *
  * Relevant parts:
- * usleep(10000); //(10 ms)
- * sem_wait(semaphores.simulation_sem);
- * each child process at start will reclame a spot of semaphores.simulation_sem
- * by giving each process a lille space to start, the parent process will
- * procede at cleanup once a spot is available (a philosopher died or so).
+ * supervise(shm);
+ * a child only exits once the simulation is over (a philosopher died or
+ * the last one got fed), the parent sleeps until the first one does and
+ * then procedes at cleanup. With --stats it reports before killing them.
+ * Every philo's meals are on the scoreboard, no need to ask them.
  *
  * @param number_of_philosophers The total number of philosophers.
- * @param philos The array of philosopher structs.
- * the simulation_active flag
- * @return 1 on failure (e.g., thread or memory allocation issues), 0 otherwise.
+ * @param f_tmpl The template every philo is a copy of.
+ * @return 1 on failure (e.g., a fork failed), 0 otherwise.
  */
-static int	execute_phils(int number_of_philosophers, t_philo *philos,
-		t_sem semaphores)
+static int	execute_phils(int number_of_philosophers, t_philo *f_tmpl)
 {
-	int		i;
-	pid_t	*child_pids;
+	long long	spawn_start;
 
-	i = 0;
-	child_pids = malloc(number_of_philosophers * sizeof(pid_t));
-	if (!child_pids)
+	if (!log_start(f_tmpl))
 		return (1);
-	while (number_of_philosophers > i++)
+	spawn_start = clock_now_us(&f_tmpl->clock);
+	if (!spawn_philos(f_tmpl, number_of_philosophers))
 	{
-		child_pids[i - 1] = fork();
-		if (child_pids[i - 1] == 0)
-			philo_cycle(&philos[i - 1]);
-		else if (child_pids[i - 1] < 0)
-		{
-			while (0 < i--)
-				kill(child_pids[i], SIGKILL);
-			return (1);
-		}
+		cleanup(f_tmpl);
+		return (1);
+	}
+	supervise(f_tmpl->shm);
+	if (f_tmpl->opts.stats)
+	{
+		meals_report(f_tmpl, clock_now_us(&f_tmpl->clock));
+		sleep_report(f_tmpl);
+		spawn_report(f_tmpl, f_tmpl->shm->t0 - spawn_start);
 	}
-	usleep(10000);
-	sem_wait(semaphores.simulation_sem);
-	cleanup(number_of_philosophers, philos, semaphores, child_pids);
+	cleanup(f_tmpl);
 	return (0);
 }
 
 int	main(int argc, char **argv)
 {
 	t_philo	f_tmpl;
-	t_philo	*philos;
-	t_sem	semaphores;
 	int		number_of_philosophers;
 
-	f_tmpl.times_eaten = 0;
-	f_tmpl.last_meal_time = 0;
-	f_tmpl.holding_forks = 0;
+	memset(&f_tmpl, 0, sizeof(t_philo));
 	if (!validate_params(argc, argv, &f_tmpl, &number_of_philosophers))
 		return (1);
-	philos = init_philos(number_of_philosophers, f_tmpl, &semaphores);
-	if (!philos)
-		return (1);
-	if (execute_phils(number_of_philosophers, philos, semaphores))
+	if (!init_shm(number_of_philosophers, &f_tmpl)
+		|| execute_phils(number_of_philosophers, &f_tmpl))
 		return (1);
+	pool_trace_save(&f_tmpl, number_of_philosophers);
+	stats_close(f_tmpl.stats_file);
+	free(f_tmpl.workload.timings);
 	return (0);
 }
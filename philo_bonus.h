@@ -6,49 +6,215 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/22 23:34:19 by amarabin          #+#    #+#             */
-/*   Updated: 2023/09/22 23:34:20 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PHILO_BONUS_H
 # define PHILO_BONUS_H
 
+# include "philo_common.h"
 # include <fcntl.h>
 # include <limits.h>
+# include <pthread.h>
 # include <semaphore.h>
 # include <signal.h>
 # include <stdio.h>
 # include <stdlib.h>
+# include <string.h>
+# include <sys/mman.h>
 # include <sys/time.h>
 # include <sys/types.h>
 # include <sys/wait.h>
 # include <unistd.h>
+# ifdef __linux__
+#  include <sys/epoll.h>
+#  include <sys/prctl.h>
+# endif
 
-typedef struct s_sem
+/*
+ * Grants of the fork pool kept by --record / --replay, at most
+ * POOL_TRACE_CAP of them; a philo waiting for his turn in replay checks on
+ * his life every POOL_POLL_US.
+ */
+# define POOL_TRACE_CAP 16777216
+# define POOL_POLL_US 1000
+# ifndef MAP_NORESERVE
+#  define MAP_NORESERVE 0
+# endif
+
+/*
+ * philo_sem_bench: processes taking the same semaphore and times each of
+ * them takes it (unless told otherwise), spins it is held for each time,
+ * name of the named semaphore it is measured on.
+ */
+# define SEM_BENCH_PROCS 4
+# define SEM_BENCH_ITERATIONS 100000
+# define SEM_BENCH_HOLD 64
+# define SEM_BENCH_NAME "philo_sem_bench"
+
+/*
+ * Stack of the watchdog thread of every child (see watchdog_start).
+ */
+# define WATCHDOG_STACK 65536
+
+/*
+ * While the children get ready, whoever forked them checks for one who died
+ * every SPAWN_POLL_US (see wait_ready and wait_go).
+ */
+# define SPAWN_POLL_US 1000
+# if defined(__linux__) && !defined(SYS_pidfd_open)
+#  define SYS_pidfd_open 434
+# endif
+
+/*
+ * The grant order of the fork pool, in a mapping shared by all the
+ * processes: cursor counts the grants made so far, ids[i] is the philo
+ * served i-th (0 if he was killed before writing it down), len the number
+ * of grants to replay.
+ */
+typedef struct s_pool_trace
+{
+	atomic_int		cursor;
+	int				mode;
+	long long		len;
+	int				ids[];
+}					t_pool_trace;
+
+/*
+ * The log ring: LOG_RING_SIZE must be a power of two, positions are free
+ * running counters masked with LOG_RING_SIZE - 1. A child finding the ring
+ * full checks again every LOG_POLL_US, as the writer does for new events.
+ */
+# define LOG_RING_SIZE 4096
+# define LOG_POLL_US 500
+
+/*
+ * A line of the log, in the slot for position pos of the ring: seq is pos
+ * while the slot is free for it, pos + 1 once the event is written.
+ */
+typedef struct s_log_slot
+{
+	atomic_uint		seq;
+	int				id;
+	int				activity;
+	long long		timestamp;
+}					t_log_slot;
+
+/*
+ * The scoreboard entry of a philo, on its own cache line: his pid, the
+ * meals he ate and the overshoot of his sleeps, written by him only. They
+ * outlive him: the parent reports them once he is killed (see
+ * sleep_report).
+ */
+typedef struct s_seat
 {
-	sem_t		*log_sem;
-	sem_t		*simulation_sem;
-	sem_t		*fork_pool;
-}				t_sem;
+	_Alignas(64) atomic_int	meals;
+	pid_t					pid;
+	t_sleep_stats			sleep_stats;
+}							t_seat;
 
+/*
+ * What the processes share, in one anonymous MAP_SHARED mapping made before
+ * the first fork: every child inherits it, there is nothing to open nor to
+ * unlink, and nothing a crash could leave behind. The fork pool is a
+ * process shared semaphore (futex based: waiting on it while it is free, or
+ * posting it while nobody waits, never enters the kernel).
+ * The log is a ring every child pushes in (see log_event) and only the
+ * parent drains: log_tail, done (set once "died" is printed), the sink and
+ * the writer thread are the parent's own.
+ * The parent needs no semaphore to learn about the end: a child leaves
+ * only when the simulation is over for everybody (see supervise).
+ * Every child writes down his pid in his seat (whoever forked him) and
+ * counts himself in ready, then waits for go: all of them start together,
+ * from t0 (see spawn_philos). failed is set by a child who could not fork
+ * his own.
+ * unfed counts down the philos yet to eat num_of_eating_times meals, from
+ * targets, the number of philos who have such a target (all or none of
+ * them, but with --workload): the one who takes it to 0 leaves, which is
+ * what wakes the parent up.
+ */
+typedef struct s_shm
+{
+	sem_t			fork_pool;
+	atomic_uint		log_head;
+	unsigned int	log_tail;
+	int				done;
+	atomic_int		writer_stop;
+	pthread_t		writer;
+	t_sink			sink;
+	t_log_slot		log[LOG_RING_SIZE];
+	atomic_int		ready;
+	atomic_int		go;
+	atomic_int		failed;
+	atomic_int		unfed;
+	int				targets;
+	long long		t0;
+	int				n;
+	t_seat			seats[];
+}					t_shm;
+
+/*
+ * holding_forks, deadline and dying are shared with the watchdog thread
+ * of the child (see watchdog): the forks to give back and the time the
+ * philo dies at if he does not eat before, and who of the two declared his
+ * death first. holding_forks only changes under pool_lock, never held
+ * while waiting on the pool: in_pool is set while the philo waits, and a
+ * fork he gets once dying is set goes back at once. holding_forks is then
+ * always the number of forks he has when he dies (see pool_acquire).
+ * config is the philo's own line of workload (see child_main), rng the
+ * state of the generator his jitter is drawn from, sleep_stats the ones in
+ * his seat.
+ */
 typedef struct s_philo
 {
-	int			id;
-	int			time_to_die;
-	int			time_to_eat;
-	int			time_to_sleep;
-	int			num_of_eating_times;
-	long long	last_meal_time;
-	long long	time_slept;
-	int			times_eaten;
-	int			holding_forks;
-	t_sem		semaphores;
-}				t_philo;
-
-int				ft_atoi(char *nptr);
-long long		get_timestamp(void);
-size_t			ft_strlen(const char *s);
-char			*ft_ulltoa(unsigned long long n);
+	int				id;
+	t_config		config;
+	t_workload		workload;
+	unsigned long long	rng;
+	long long		now;
+	long long		last_meal_time;
+	int				times_eaten;
+	atomic_int		holding_forks;
+	pthread_mutex_t	pool_lock;
+	atomic_int		in_pool;
+	atomic_llong	deadline;
+	atomic_int		dying;
+	t_shm			*shm;
+	t_clock			clock;
+	t_opts			opts;
+	t_sleep_stats	*sleep_stats;
+	t_pool_trace	*pool_trace;
+	long long		fork_wait;
+	t_stats_head	*stats_file;
+}					t_philo;
+
 void			*philo_cycle(void *arg);
+void			log_event(t_philo *philo, long long now, int activity);
+void			log_activity(t_philo *philo, int activity);
+void			verify_death(t_philo *philo);
+void			philo_die(t_philo *philo, long long now);
+int				watchdog_start(t_philo *philo);
+void			supervise(t_shm *shm);
+size_t			shm_size(int n_philos);
+int				spawn_philos(t_philo *f_tmpl, int n_philos);
+void			child_main(t_philo *f_tmpl, int id);
+int				log_start(t_philo *f_tmpl);
+void			log_stop(t_philo *f_tmpl);
+void			spawn_report(t_philo *f_tmpl, long long spawn_us);
+void			meals_report(t_philo *f_tmpl, long long ended_at);
+void			sleep_report(t_philo *f_tmpl);
+long long		sleep_margin(t_philo *p, long long left, long long chk_int);
+int				pool_trace_init(t_philo *f_tmpl, int n_philos);
+void			pool_take(t_philo *p);
+int				pool_acquire(t_philo *p);
+void			pool_put(t_philo *p);
+void			pool_trace_save(t_philo *f_tmpl, int n_philos);
+int				stats_file_init(t_philo *f_tmpl, int n_philos);
+void			stats_publish(t_philo *p, int activity);
+long long		now_ns(void);
+void			hammer(sem_t *sem, int named, t_hist *hist, int iterations);
+sem_t			*sem_make(int named);
+void			sem_drop(sem_t *sem, int named);
 
 #endif
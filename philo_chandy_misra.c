@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_chandy_misra.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:44:19 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:43:11 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Chandy-Misra: every fork belongs to one of its two philos at a time and
+ * starts dirty with the one of lower id, which makes the precedence graph
+ * acyclic. The fork's lock (the one chosen with --fork-lock) only guards
+ * its message state, it is never held while eating.
+ * Channels are locked in index order, as with the resource hierarchy.
+ */
+void	setup_cm(t_philo *p)
+{
+	p->first_fork = p->left_fork;
+	p->second_fork = p->right_fork;
+	if (p->right_fork < p->left_fork)
+	{
+		p->first_fork = p->right_fork;
+		p->second_fork = p->left_fork;
+	}
+	if (!p->first_fork->owner || p->first_fork->owner > p->id)
+		p->first_fork->owner = p->id;
+	if (!p->second_fork->owner || p->second_fork->owner > p->id)
+		p->second_fork->owner = p->id;
+	p->first_fork->dirty = 1;
+	p->second_fork->dirty = 1;
+}
+
+/**
+ * A request for a fork: granted on the spot if it is dirty and its owner is
+ * not eating with it (a clean fork stays with its hungry owner), otherwise
+ * it is left pending for the owner to honour when he is done.
+ */
+static int	request(t_fork *fork, int id)
+{
+	if (fork->owner == id)
+		return (1);
+	if (fork->dirty && !fork->in_use)
+	{
+		fork->owner = id;
+		fork->dirty = 0;
+		fork->req = 0;
+		return (1);
+	}
+	fork->req = id;
+	return (0);
+}
+
+/**
+ * Both requests are always sent (no short-circuit), and both forks are
+ * marked in use at once, under both channels, once they are ours.
+ */
+static int	try_take(t_philo *p)
+{
+	int	got;
+
+	fork_lock(p->first_fork, &p->qnodes[0], p->id);
+	fork_lock(p->second_fork, &p->qnodes[1], p->id);
+	got = request(p->first_fork, p->id) & request(p->second_fork, p->id);
+	if (got)
+	{
+		p->first_fork->in_use = 1;
+		p->second_fork->in_use = 1;
+	}
+	fork_unlock(p->second_fork);
+	fork_unlock(p->first_fork);
+	return (got);
+}
+
+/**
+ * Both forks are acquired on the first call, the second one has nothing
+ * left to do. Between attempts we sleep on our doorbell, rung by the
+ * neighbour that sends us a fork (the bell is read before the attempt, so
+ * a fork sent meanwhile is not missed).
+ */
+void	take_cm(t_philo *p, int nth)
+{
+	int	bell;
+
+	if (nth == 1)
+		return ;
+	while (1)
+	{
+		bell = atomic_load_explicit(&p->doorbell, memory_order_acquire);
+		if (try_take(p))
+			break ;
+		park_wait(&p->doorbell, bell,
+			p->shared_resources->engine.n_shards != 0, STRATEGY_POLL_US);
+		verify_death(p);
+	}
+	p->held = 2;
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_chandy_misra_put.c                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:49:27 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:43:11 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Done eating with a fork: it gets dirty and, if the neighbour asked for it
+ * meanwhile, it is cleaned and sent to him.
+ * Return: the id of the philo the fork was sent to, 0 if none.
+ */
+static int	release(t_fork *fork, t_qnode *node, int id)
+{
+	int	to;
+
+	fork_lock(fork, node, id);
+	fork->in_use = 0;
+	fork->dirty = 1;
+	to = fork->req;
+	if (to && to != fork->owner)
+	{
+		fork->owner = to;
+		fork->dirty = 0;
+		fork->req = 0;
+	}
+	else
+		to = 0;
+	fork_unlock(fork);
+	return (to);
+}
+
+static void	ring(t_shared *shared, int id)
+{
+	atomic_int	*bell;
+
+	if (!id)
+		return ;
+	bell = &shared->philos[id - 1].doorbell;
+	atomic_fetch_add_explicit(bell, 1, memory_order_release);
+	park_wake(bell, 1, shared->engine.n_shards != 0);
+}
+
+/**
+ * Forks only leave the table in pairs, after a meal: a philo that stops
+ * while still waiting holds nothing in use.
+ */
+void	put_cm(t_philo *p)
+{
+	int	to;
+
+	if (p->held == 2)
+	{
+		to = release(p->first_fork, &p->qnodes[0], p->id);
+		ring(p->shared_resources, to);
+		to = release(p->second_fork, &p->qnodes[1], p->id);
+		ring(p->shared_resources, to);
+	}
+	p->held = 0;
+}
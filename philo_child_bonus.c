@@ -0,0 +1,101 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_child_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:25:26 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:25:26 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * Waits for go, checking every SPAWN_POLL_US for a philo under him (see
+ * --spawn=tree) who died before being ready: he reports it as a failed
+ * fork, since only he can reap it.
+ * Return: 0 if the spawn failed, and go is never coming.
+ */
+static int	wait_go(t_shm *shm)
+{
+	while (!atomic_load(&shm->go))
+	{
+		if (waitpid(-1, NULL, WNOHANG) > 0)
+		{
+			atomic_store(&shm->failed, 1);
+			futex_wake(&shm->ready, 1, 1);
+		}
+		if (atomic_load(&shm->failed))
+			return (0);
+		futex_wait(&shm->go, 0, 1, SPAWN_POLL_US);
+	}
+	return (1);
+}
+
+/**
+ * With --spawn=tree, forks the philos under philo id: 2 * id and 2 * id + 1
+ * (while there are that many). A child just takes the id he was forked for
+ * and goes on from there, forking the ones under him.
+ * Return: the id of the philo the calling process is, in the end.
+ */
+static int	fork_subtree(t_philo *f_tmpl, int id)
+{
+	t_shm	*shm;
+	pid_t	pid;
+	int		i;
+
+	shm = f_tmpl->shm;
+	i = 2 * id - 1;
+	while (f_tmpl->opts.spawn == SPAWN_TREE && ++i <= shm->n
+		&& i <= 2 * id + 1)
+	{
+		pid = fork();
+		if (pid < 0)
+		{
+			atomic_store(&shm->failed, 1);
+			futex_wake(&shm->ready, 1, 1);
+		}
+		if (pid == 0)
+		{
+			id = i;
+			i = 2 * id - 1;
+		}
+	}
+	return (id);
+}
+
+/**
+ * The entry point of a child, lean: all he gets is his id and f_tmpl, the
+ * settings and the shared mappings, as he inherited them (nobody copies a
+ * table of philos for him). With --spawn=tree he first forks the philos
+ * under him, who do the same (see fork_subtree): the table is forked by
+ * log2(n) generations working in parallel.
+ * He takes his own timings from the --workload, if any, and seeds his
+ * jitter. Then he registers and waits with everybody else for go; the
+ * watchdog and the cycle only start from t0 (see philo_cycle). If the spawn
+ * failed instead he just leaves: cleanup may have missed him if he had not
+ * registered yet.
+ */
+void	child_main(t_philo *f_tmpl, int id)
+{
+	t_philo	philo;
+	t_shm	*shm;
+
+	shm = f_tmpl->shm;
+	id = fork_subtree(f_tmpl, id);
+	philo = *f_tmpl;
+	philo.id = id;
+	if (philo.workload.timings)
+		philo.config = philo.workload.timings[id - 1];
+	philo.rng = rng_seed(philo.workload.seed, id);
+	philo.sleep_stats = &shm->seats[id - 1].sleep_stats;
+	shm->seats[id - 1].pid = getpid();
+	atomic_fetch_add(&shm->ready, 1);
+	futex_wake(&shm->ready, 1, 1);
+	if (!wait_go(shm))
+		exit(1);
+	philo_cycle(&philo);
+	exit(0);
+}
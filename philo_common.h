@@ -0,0 +1,393 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_common.h                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 11:02:45 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef PHILO_COMMON_H
+# define PHILO_COMMON_H
+
+# ifndef _GNU_SOURCE
+#  define _GNU_SOURCE
+# endif
+# include <errno.h>
+# include <fcntl.h>
+# include <limits.h>
+# include <sched.h>
+# include <signal.h>
+# include <stdatomic.h>
+# include <stddef.h>
+# include <stdio.h>
+# include <stdlib.h>
+# include <string.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <time.h>
+# include <unistd.h>
+
+# ifdef __linux__
+#  include <linux/futex.h>
+#  include <sys/syscall.h>
+# endif
+
+# if defined(__x86_64__) || defined(__i386__)
+#  include <x86intrin.h>
+#  define PHILO_HAS_TSC 1
+# else
+#  define PHILO_HAS_TSC 0
+# endif
+
+/*
+ * Longest possible line: 20 digits of timestamp, 10 of id, the longest
+ * activity ("has taken a fork"), two spaces and the newline.
+ */
+# define LOG_LINE_MAX 64
+# define DEFAULT_LOG_BATCH 64
+# define DEFAULT_LOG_FLUSH_MS 2
+
+/*
+ * Smallest --stack-size accepted, in KB (a thread cannot have less).
+ */
+# define MIN_STACK_KB 16
+
+/*
+ * Record and replay of the fork grants (--record, --replay).
+ */
+# define TRACE_MAGIC "PHTR"
+# define TRACE_VERSION 1
+
+/*
+ * Latency histograms (--histograms): values up to 2^HIST_MAX_BITS us, in
+ * buckets 1/2^HIST_SUB_BITS of a power of two wide (see hist_record).
+ */
+# define HIST_SUB_BITS 6
+# define HIST_MAX_BITS 40
+# define HIST_BUCKETS 1152
+
+/*
+ * Live counters of the philos (--stats-file), see t_stats_head. A reader
+ * gives up on a slot after STATS_READ_RETRIES tries (see stats_read).
+ */
+# define STATS_MAGIC 0x54534850
+# define STATS_VERSION 1
+# define STATS_READ_RETRIES 1000
+
+/*
+ * What a philo is doing, as logged (and as published in the stats file).
+ */
+typedef enum e_activity
+{
+	ACT_FORK,
+	ACT_EAT,
+	ACT_SLEEP,
+	ACT_THINK,
+	ACT_DIED
+}				t_activity;
+
+typedef enum e_clock_src
+{
+	CLK_MONO,
+	CLK_RAW,
+	CLK_TSC,
+	CLK_VIRTUAL
+}				t_clock_src;
+
+typedef enum e_fork_lock
+{
+	LOCK_PTHREAD,
+	LOCK_TICKET,
+	LOCK_MCS,
+	LOCK_ADAPTIVE
+}				t_fork_lock;
+
+typedef enum e_strategy_kind
+{
+	STRAT_PARITY,
+	STRAT_HIERARCHY,
+	STRAT_WAITER,
+	STRAT_WAITER_HALF,
+	STRAT_CHANDY_MISRA
+}				t_strategy_kind;
+
+typedef enum e_grants_mode
+{
+	GRANTS_OFF,
+	GRANTS_RECORD,
+	GRANTS_REPLAY
+}				t_grants_mode;
+
+/*
+ * TRACE_FORKS: per fork, who of its two users got it at every grant
+ * (mandatory). TRACE_POOL: the ids of the philos in the order the fork pool
+ * served them (bonus).
+ */
+typedef enum e_trace_kind
+{
+	TRACE_FORKS,
+	TRACE_POOL
+}				t_trace_kind;
+
+typedef enum e_engine_kind
+{
+	ENGINE_THREADS,
+	ENGINE_FIBERS,
+	ENGINE_SHARDS
+}				t_engine_kind;
+
+typedef enum e_placement
+{
+	PLACE_NONE,
+	PLACE_CORE,
+	PLACE_NODE
+}				t_placement;
+
+typedef enum e_fork_link
+{
+	LINK_SHM,
+	LINK_SOCKET
+}				t_fork_link;
+
+typedef enum e_spawn
+{
+	SPAWN_FORK,
+	SPAWN_TREE
+}				t_spawn;
+
+typedef enum e_jitter
+{
+	JITTER_NONE,
+	JITTER_UNIFORM,
+	JITTER_NORMAL
+}				t_jitter;
+
+typedef enum e_format
+{
+	FORMAT_CSV,
+	FORMAT_JSON
+}				t_format;
+
+/*
+ * Options given as --name=value before the positional parameters.
+ */
+typedef struct s_opts
+{
+	int			log_batch;
+	int			log_flush_ms;
+	int			clock_source;
+	int			stats;
+	int			histograms;
+	char		*stats_path;
+	int			fork_lock;
+	int			strategy;
+	int			engine;
+	int			workers;
+	int			shards;
+	int			fork_link;
+	int			virtual_time;
+	long long	run_for_ms;
+	int			grants;
+	char		*trace_path;
+	int			format;
+	int			placement;
+	int			stack_kb;
+	int			spawn;
+	char		*workload_path;
+}				t_opts;
+
+/*
+ * The timings of a philo (milliseconds) and the meals he has to eat (-1
+ * for no limit): the positional parameters, the same for every philo, or
+ * his own line of a --workload file. jitter is the distribution of the
+ * time added to each of his meals and sleeps: uniform in +-jitter_ms, or
+ * normal with jitter_ms of standard deviation (see timing_us).
+ * Written once before the simulation starts, only read afterwards.
+ */
+typedef struct s_config
+{
+	int			time_to_die;
+	int			time_to_eat;
+	int			time_to_sleep;
+	int			num_of_eating_times;
+	int			jitter;
+	int			jitter_ms;
+}				t_config;
+
+/*
+ * A --workload file (path, NULL if none), parsed once at startup: the size
+ * of the table, the timings of every philo (philo id has timings[id - 1],
+ * NULL if they all have the defaults) and the seed their jitter is drawn
+ * from.
+ */
+typedef struct s_workload
+{
+	const char			*path;
+	int					n;
+	unsigned long long	seed;
+	t_config			*timings;
+}						t_workload;
+
+/*
+ * Time source of the simulation, read only once set up. origin is in the
+ * units of the source (microseconds, or ticks for the TSC), mono_origin is
+ * the same instant on CLOCK_MONOTONIC, the clock we can sleep on.
+ * A CLK_VIRTUAL clock reads virtual_now, moved forward by the simulation
+ * itself (--virtual-time).
+ */
+typedef struct s_clock
+{
+	int				source;
+	long long		origin;
+	long long		mono_origin;
+	double			us_per_tick;
+	long long		spin_us;
+	atomic_llong	virtual_now;
+}				t_clock;
+
+/*
+ * Overshoot (microseconds past the deadline) of the calls to sleep_until.
+ */
+typedef struct s_sleep_stats
+{
+	long long	calls;
+	long long	total_overshoot;
+	long long	max_overshoot;
+}				t_sleep_stats;
+
+/*
+ * HDR-style histogram of latencies in microseconds: exact below
+ * 2^HIST_SUB_BITS, then with a relative error under 2^-(HIST_SUB_BITS - 1).
+ */
+typedef struct s_hist
+{
+	long long		count;
+	long long		max;
+	unsigned int	buckets[HIST_BUCKETS];
+}				t_hist;
+
+/*
+ * One philo in the stats file, on its own cache line, written by that philo
+ * only. seq is a seqlock: odd while the fields are being updated, so a
+ * reader retries until it reads the same even value before and after
+ * copying them (see stats_read). Times in microseconds since mono_origin.
+ */
+typedef struct s_stats_slot
+{
+	_Alignas(64) atomic_uint	seq;
+	atomic_int					state;
+	atomic_llong				times_eaten;
+	atomic_llong				fork_wait_us;
+	atomic_llong				last_meal_us;
+}				t_stats_slot;
+
+/*
+ * A consistent copy of a slot, or the last one tried if stale is set.
+ */
+typedef struct s_stats_view
+{
+	int			state;
+	long long	times_eaten;
+	long long	fork_wait_us;
+	long long	last_meal_us;
+	int			stale;
+}				t_stats_view;
+
+/*
+ * The stats file: this header, then one slot per philo. The same layout is
+ * mapped by the threads of philo and by the processes of philo_bonus.
+ * mono_origin (CLOCK_MONOTONIC, us) is the start of the simulation, running
+ * drops to 0 once it is over, died is the id of the philo who died.
+ */
+typedef struct s_stats_head
+{
+	_Alignas(64) unsigned int	magic;
+	unsigned int				version;
+	int							n;
+	int							pid;
+	long long					mono_origin;
+	atomic_int					running;
+	atomic_int					died;
+	t_stats_slot				slots[];
+}				t_stats_head;
+
+/*
+ * Buffered output: lines are appended to buf and written with a single
+ * write(2) every `batch` lines or `flush_ms` milliseconds.
+ */
+typedef struct s_sink
+{
+	int			fd;
+	char		*buf;
+	size_t		len;
+	int			lines;
+	int			batch;
+	long long	flush_ms;
+	long long	last_flush;
+}				t_sink;
+
+int				ft_atoi(char *nptr);
+size_t			ft_strlen(const char *s);
+char			*ft_ulltoa(unsigned long long n);
+const char		*activity_name(int activity);
+size_t			format_line(char *dst, long long timestamp, int id,
+					const char *msg);
+int				sink_init(t_sink *sink, int fd, int batch, int flush_ms);
+void			sink_line(t_sink *sink, long long timestamp, int id,
+					const char *msg);
+void			sink_flush(t_sink *sink);
+void			sink_tick(t_sink *sink, long long now);
+int				set_opt(t_opts *opts, char *arg);
+int				parse_opts(int argc, char **argv, t_opts *opts);
+int				table_params(int argc, char **argv, t_config *cfg,
+					t_workload *wl);
+long long		parse_num(const char *s);
+char			*next_token(char **s);
+int				workload_load(const char *path, const t_config *defaults,
+					t_workload *wl);
+int				timing_valid(const t_config *cfg);
+int				jitter_parse(t_config *c, const char *value);
+unsigned long long	rng_seed(unsigned long long seed, int id);
+long long		timing_us(const t_config *cfg, int ms,
+					unsigned long long *rng);
+char			*opt_value(char *arg, const char *name);
+int				opt_flag(char *arg, const char *name);
+int				opt_choice(const char *value, const char **names);
+void			clock_setup(t_clock *clock, int source);
+long long		clock_now_us(const t_clock *clock);
+long long		sleep_until(const t_clock *clock, long long deadline,
+					t_sleep_stats *stats);
+void			sleep_calibrate(t_clock *clock);
+void			sleep_stats_record(t_sleep_stats *stats, long long overshoot);
+void			sleep_stats_add(t_sleep_stats *dst, const t_sleep_stats *src);
+void			sleep_stats_print(const char *who,
+					const t_sleep_stats *stats);
+void			hist_record(t_hist *hist, long long value);
+void			hist_merge(t_hist *dst, const t_hist *src);
+long long		hist_percentile(const t_hist *hist, double q);
+void			hist_print(const char *what, const t_hist *hist);
+size_t			stats_size(int n);
+t_stats_head	*stats_create(const char *path, int n);
+void			stats_close(t_stats_head *head);
+void			stats_write(t_stats_slot *slot, const t_stats_view *view);
+void			stats_read(t_stats_slot *slot, t_stats_view *view);
+void			print_table(t_stats_head *head, t_stats_view *views,
+					long long now);
+void			print_prom(t_stats_head *head, t_stats_view *views);
+void			print_snapshot(t_stats_head *head, t_stats_view *views,
+					int prom);
+int				write_all(int fd, const void *buf, size_t len);
+int				read_all(int fd, void *buf, size_t len);
+char			*read_file(const char *path);
+int				trace_create(const char *path, int kind, int n);
+int				trace_open(const char *path, int kind, int n);
+void			futex_wait(atomic_int *addr, int val, int pshared,
+					long long timeout_us);
+void			futex_wake(atomic_int *addr, int n, int pshared);
+void			cpu_relax(void);
+
+#endif
@@ -6,131 +6,177 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/18 16:02:38 by amarabin          #+#    #+#             */
-/*   Updated: 2023/09/22 23:30:04 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
+/**
+ * Both forks in hand: the wait since "is thinking" goes in fork_wait and
+ * the --histograms, and the meal starts when "is eating" is logged, so
+ * last_meal_time takes that same instant (the one cached by the last
+ * verify_death), and the new deadline is published for the death monitor.
+ * max_hunger (the longest wait between two meals) is kept for --stats, as
+ * the forks that just came from another numa node (see placement_handoff).
+ */
+static void	start_meal(t_philo *philo, long long thinking)
+{
+	philo->fork_wait += philo->now - thinking;
+	if (philo->hists)
+		hist_record(&philo->hists[HIST_SECOND_FORK], philo->now - thinking);
+	log_activity(philo, ACT_FORK);
+	log_activity(philo, ACT_EAT);
+	if (philo->now - philo->last_meal_time > philo->max_hunger)
+		philo->max_hunger = philo->now - philo->last_meal_time;
+	philo->last_meal_time = philo->now;
+	atomic_store_explicit(&philo->deadline,
+		philo->now + philo->config->time_to_die * 1000LL,
+		memory_order_release);
+	if (philo->shared_resources->opts.stats)
+		placement_handoff(philo);
+}
+
 /**
  * Executes the eating cycle for a philo in the simulation (picking forks,
  * eating for a given time, release the forks)
+ * The meal lasts time_to_eat, give or take the philo's jitter (see
+ * timing_us), as does his sleep.
  *
+ * How the forks are obtained is up to the strategy chosen with --strategy
+ * (see strategy_init): take and put are its hooks, the cycle is the same
+ * for all of them.
  * If a philosopher has eaten the number of times specified in the optional
  * input parameter, the simulation ends for that thread.
- * Since while a philo waits for a mutex to be released will stay idle, every
- * time we have a potential deathlock we check for the eventual philo death.
+ * Since while a philo waits for a fork will stay idle, every time we have a
+ * potential deathlock we check for the eventual philo death.
+ * times_eaten is kept for --stats even when there is no meal count, the
+ * fork waits (from "is thinking") go in the --histograms (see start_meal).
  *
  * @param philo Pointer to the t_philo structure representing the philo.
- * @param fork1 Pointer to the mutex for the first fork to be acquired.
- * @param fork2 Pointer to the mutex for the second fork to be acquired.
- *
  */
-static void	eat(t_philo *philo, pthread_mutex_t *fork1, pthread_mutex_t *fork2)
+static void	eat(t_philo *philo)
 {
-	log_activity(philo, "is thinking", NULL, NULL);
-	pthread_mutex_lock(fork1);
-	verify_death(philo, fork1, NULL);
-	log_activity(philo, "has taken a fork", fork1, NULL);
-	pthread_mutex_lock(fork2);
-	verify_death(philo, fork1, fork2);
-	log_activity(philo, "has taken a fork", fork1, fork2);
-	log_activity(philo, "is eating", fork1, fork2);
-	usleep(philo->time_to_eat * 1000);
-	pthread_mutex_unlock(fork2);
-	pthread_mutex_unlock(fork1);
-	philo->last_meal_time = get_timestamp();
-	if (philo->num_of_eating_times != -1)
+	const t_strategy	*strategy;
+	long long			thinking;
+
+	strategy = &philo->shared_resources->strategy;
+	verify_death(philo);
+	log_activity(philo, ACT_THINK);
+	thinking = philo->now;
+	strategy->take(philo, 0);
+	verify_death(philo);
+	if (philo->hists)
+		hist_record(&philo->hists[HIST_FIRST_FORK], philo->now - thinking);
+	log_activity(philo, ACT_FORK);
+	strategy->take(philo, 1);
+	verify_death(philo);
+	start_meal(philo, thinking);
+	engine_sleep_until(philo, philo->now + timing_us(philo->config,
+			philo->config->time_to_eat, &philo->rng));
+	strategy->put(philo);
+	philo->times_eaten++;
+	if (philo->config->num_of_eating_times != -1
+		&& philo->times_eaten >= philo->config->num_of_eating_times)
 	{
-		philo->times_eaten++;
-		if (philo->times_eaten >= philo->num_of_eating_times)
-		{
-			pthread_mutex_lock(&(philo->shared_resources->simulation_mutex));
-			philo->shared_resources->simulation_active = 0;
-			pthread_mutex_unlock(&(philo->shared_resources->simulation_mutex));
-			pthread_exit(NULL);
-		}
+		stop_simulation(philo->shared_resources, NULL, 0, 0);
+		engine_exit(philo);
 	}
 }
 
+/**
+ * Breaks the sleep for a meal (see erratic_sleep).
+ * Return: how long the meal took, to push the end of the sleep by.
+ */
+static long long	eat_break(t_philo *p)
+{
+	long long	start;
+
+	start = p->now;
+	eat(p);
+	verify_death(p);
+	log_activity(p, ACT_SLEEP);
+	return (p->now - start);
+}
+
 /**
  * Makes the philosopher sleep for a given period, but while keep checking on
  * his life and trying to eat before the end the sleep cycle if needed.
  *
  * @param philo       the philo.
- * @param fork1       The first fork to pick up if in need to eat.
- * @param fork2       The second fork to pick up if in need to eat.
  *
- * The amount of accumulated time slept is keept in the var philo->time_slept.
- * We calculate a safety margin as the smaller between the time to die * 0.9
- * or the time left in the sleeping cycle.
- * If this margin becomes smaller than the time since the last meal we stop the
- * sleep cycle and send the philo to eat.
+ * The end of the sleep is an absolute deadline, and every check interval is
+ * slept with engine_sleep_until on an absolute time: the time slept is what the
+ * clock says, not the sum of what we asked for, so there is no drift.
+ * If the time since the last meal exceeds the safety margin (see
+ * sleep_margin) we stop the sleep cycle and send the philo to eat; the time
+ * spent eating is then added to the deadline, and the sleep resumes.
  * Once is done with eating the Philosopher will start thinking...this at least
  */
-static void	erratic_sleep(t_philo *p, pthread_mutex_t *fork1,
-		pthread_mutex_t *fork2)
+static void	erratic_sleep(t_philo *p)
 {
 	long long	chk_int;
-	long long	sft_mrg;
+	long long	deadline;
+	long long	next;
 
-	chk_int = p->time_to_sleep / 10;
-	if (p->time_to_sleep > p->time_to_die)
-		chk_int = p->time_to_die / 10;
-	log_activity(p, "is sleeping", NULL, NULL);
-	while (p->time_slept < p->time_to_sleep)
+	chk_int = p->config->time_to_sleep * 100LL;
+	if (p->config->time_to_sleep > p->config->time_to_die)
+		chk_int = p->config->time_to_die * 100LL;
+	verify_death(p);
+	log_activity(p, ACT_SLEEP);
+	deadline = p->now + timing_us(p->config, p->config->time_to_sleep,
+			&p->rng);
+	while (p->now < deadline)
 	{
-		sft_mrg = p->time_to_die * 0.9;
-		// Review this, also in the bonus proj!!
-		if (p->time_to_die < p->time_to_sleep - p->time_slept - chk_int)
-			sft_mrg = (p->time_to_sleep - p->time_slept - chk_int) * 0.9;
-		if (get_timestamp() - p->last_meal_time <= sft_mrg)
-		{
-			eat(p, fork1, fork2);
-			log_activity(p, "is sleeping", NULL, NULL);
-		}
-		usleep(chk_int);
-		p->time_slept += chk_int;
-		if (p->time_to_sleep - p->time_slept < chk_int)
-			chk_int = p->time_to_sleep - p->time_slept;
-		verify_death(p, NULL, NULL);
+		if (p->now - p->last_meal_time
+			>= sleep_margin(p, deadline - p->now, chk_int))
+			deadline += eat_break(p);
+		next = p->now + chk_int;
+		if (next > deadline)
+			next = deadline;
+		engine_sleep_until(p, next);
+		verify_death(p);
 	}
-	p->time_slept = 0;
-	log_activity(p, "is thinking", NULL, NULL);
+	log_activity(p, ACT_THINK);
 }
 
 /**
  * This function represents the behavior of each philo in the simulation.
  *
- * In order to avoid deadlocks and conflicts we scrumble up the starting state:
- *  each philo with an even ID will start by sleeping, the others by eating.
- * The even's will also try to pick first the left fork while the odd the right
+ * With the parity strategy we scrumble up the starting state to avoid
+ * conflicts: each philo with an even ID will start by sleeping, the others
+ * by eating, and with an odd number of philos they think before eating
+ * again (see philo_think). Which fork a philo picks first is also up to the
+ * strategy.
  *
  * The function will also check for the philo's death using `verify_death`.
+ * Every philo starts from the same t0, his last meal time, once they are
+ * all released (see engine_go); the first one through records when.
  *
  * @param arg A pointer to the `t_philo` created in the main program.
  */
 void	*philo_cycle(void *arg)
 {
-	t_philo	*philo;
+	t_philo		*philo;
+	t_shared	*shared;
+	long long	first;
 
 	philo = (t_philo *)arg;
-	philo->last_meal_time = get_timestamp();
-	philo->time_slept = 0;
+	shared = philo->shared_resources;
+	engine_wait_start(shared);
+	philo->now = clock_now_us(&shared->clock);
+	first = -1;
+	atomic_compare_exchange_strong_explicit(&shared->first_event, &first,
+		philo->now, memory_order_relaxed, memory_order_relaxed);
 	philo->times_eaten = 0;
+	if (shared->strategy.stagger && philo->id % 2 == 0)
+		erratic_sleep(philo);
 	while (1)
 	{
-		if (philo->id % 2 == 0)
-		{
-			erratic_sleep(philo, philo->left_fork, philo->right_fork);
-			eat(philo, philo->left_fork, philo->right_fork);
-		}
-		if (philo->id % 2 != 0)
-		{
-			eat(philo, philo->right_fork, philo->left_fork);
-			erratic_sleep(philo, philo->right_fork, philo->left_fork);
-		}
-		verify_death(philo, NULL, NULL);
+		eat(philo);
+		erratic_sleep(philo);
+		philo_think(philo);
+		verify_death(philo);
 	}
 	return (NULL);
 }
@@ -6,52 +6,29 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/18 16:02:38 by amarabin          #+#    #+#             */
-/*   Updated: 2023/09/22 23:23:33 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo_bonus.h"
 
-/**
- * We write a log on screen.
- * The reason for using a sem is that at high speed the screen can become
- * jumbled of messages.
- */
-static void	log_activity(t_philo *philo, const char *activity)
-{
-	sem_wait(philo->semaphores.log_sem);
-	printf("%lld %d %s\n", get_timestamp(), philo->id, activity);
-	sem_post(philo->semaphores.log_sem);
-}
-
-/**
- * We verify if ((get_timestamp()-philo->last_meal_time) >= philo->time_to_die)
- * if so we update the state of the simulation and we release each resource
- * keept by the thread.
- * The reason for using a sem is to release the simulation_sem so the parent
- * process will be able to perceive the event and terminate all the processes
- */
-static void	verify_death(t_philo *philo)
-{
-	if ((get_timestamp() - philo->last_meal_time) >= philo->time_to_die)
-	{
-		while (philo->holding_forks--)
-			sem_post(philo->semaphores.fork_pool);
-		log_activity(philo, "died");
-		sem_post(philo->semaphores.simulation_sem);
-		exit(0);
-	}
-}
-
 /**
  * Executes the eating cycle for a philo in the simulation (picking forks,
  * eating for a given time, release the forks)
+ * The meal lasts time_to_eat, give or take the philo's jitter (see
+ * timing_us), as does his sleep.
  *
- * If a philosopher has eaten the number of times specified in the optional
- * input parameter, the simulation ends for that thread.
+ * Every meal goes on the scoreboard. Once a philosopher has eaten the number
+ * of times specified in the optional input parameter he counts himself fed
+ * (and goes on as before): the last one to do so ends the simulation, for
+ * everybody since the parent is watching, by leaving.
  * Since while a philo waits for a sem to be released will stay idle, every
  * time we have a potential deathlock we check for the eventual philo death.
+ * The meal starts when "is eating" is logged, so last_meal_time takes that
+ * same instant (the one cached by the last verify_death).
  * Relevant parts:
+ * The forks are taken through pool_take, which records or replays the order
+ * the pool grants them in (--record, --replay).
  * sem_wait(sem_t *sem): decrements (locks) the semaphore pointed to by sem.
  * If the semaphore's value is > 0 the decrement proceeds, and the function
  * returns immediately. If the semaphore currently has the value zero, then
@@ -66,32 +43,45 @@ static void	verify_death(t_philo *philo)
  */
 static void	eat(t_philo *p)
 {
-	log_activity(p, "is thinking");
-	sem_wait(p->semaphores.fork_pool);
-	p->holding_forks++;
+	long long	thinking;
+
 	verify_death(p);
-	log_activity(p, "has taken a fork");
-	sem_wait(p->semaphores.fork_pool);
-	p->holding_forks++;
+	log_activity(p, ACT_THINK);
+	thinking = p->now;
+	pool_take(p);
 	verify_death(p);
-	log_activity(p, "has taken a fork");
-	log_activity(p, "is eating");
-	usleep(p->time_to_eat * 1000);
-	sem_post(p->semaphores.fork_pool);
-	sem_post(p->semaphores.fork_pool);
-	p->holding_forks = 0;
-	p->last_meal_time = get_timestamp();
-	if (p->num_of_eating_times != -1)
-	{
-		p->times_eaten++;
-		if (p->times_eaten >= p->num_of_eating_times)
-		{
-			sem_post(p->semaphores.simulation_sem);
-			// printf("%lld %d %s%d\n", get_timestamp(), p->id,
-			// 	p->times_eaten "n.Eats reached = ");
-			exit(0);
-		}
-	}
+	log_activity(p, ACT_FORK);
+	pool_take(p);
+	verify_death(p);
+	p->fork_wait += p->now - thinking;
+	log_activity(p, ACT_FORK);
+	log_activity(p, ACT_EAT);
+	p->last_meal_time = p->now;
+	atomic_store(&p->deadline, p->now + p->config.time_to_die * 1000LL);
+	sleep_until(&p->clock, p->now + timing_us(&p->config,
+			p->config.time_to_eat, &p->rng), p->sleep_stats);
+	pool_put(p);
+	p->times_eaten++;
+	atomic_store_explicit(&p->shm->seats[p->id - 1].meals, p->times_eaten,
+		memory_order_relaxed);
+	if (p->times_eaten == p->config.num_of_eating_times
+		&& atomic_fetch_sub(&p->shm->unfed, 1) == 1)
+		exit(0);
+}
+
+/**
+ * Breaks the sleep for a meal (see erratic_sleep).
+ * Return: how long the meal took, to push the end of the sleep by.
+ */
+static long long	eat_break(t_philo *p)
+{
+	long long	start;
+
+	start = p->now;
+	eat(p);
+	verify_death(p);
+	log_activity(p, ACT_SLEEP);
+	return (p->now - start);
 }
 
 /**
@@ -99,44 +89,62 @@ static void	eat(t_philo *p)
  * his life and trying to eat before the end the sleep cycle if needed.
  *
  * @param philo       the philo.
- * @param fork1       The first fork to pick up if in need to eat.
- * @param fork2       The second fork to pick up if in need to eat.
  *
- * The amount of accumulated time slept is keept in the var philo->time_slept.
- * We calculate a safety margin as the smaller between the time to die * 0.9
- * or the time left in the sleeping cycle.
- * If this margin becomes smaller than the time since the last meal we stop the
- * sleep cycle and send the philo to eat.
+ * The end of the sleep is an absolute deadline, and every check interval is
+ * slept with sleep_until on an absolute time: the time slept is what the
+ * clock says, not the sum of what we asked for, so there is no drift.
+ * If the time since the last meal exceeds the safety margin (see
+ * sleep_margin) we stop the sleep cycle and send the philo to eat; the time
+ * spent eating is then added to the deadline, and the sleep resumes.
  * Once is done with eating the Philosopher will start thinking...this at least
  */
 static void	erratic_sleep(t_philo *p)
 {
 	long long	chk_int;
-	long long	sft_margn;
+	long long	deadline;
+	long long	next;
 
-	chk_int = p->time_to_sleep / 10;
-	if (p->time_to_sleep > p->time_to_die)
-		chk_int = p->time_to_die / 10;
-	log_activity(p, "is sleeping");
-	while (p->time_slept < p->time_to_sleep)
+	chk_int = p->config.time_to_sleep * 100LL;
+	if (p->config.time_to_sleep > p->config.time_to_die)
+		chk_int = p->config.time_to_die * 100LL;
+	verify_death(p);
+	log_activity(p, ACT_SLEEP);
+	deadline = p->now + timing_us(&p->config, p->config.time_to_sleep,
+			&p->rng);
+	while (p->now < deadline)
 	{
-		sft_margn = p->time_to_die * 0.9;
-		// Review this using pen and paper, in both projects!!!!!
-		if (p->time_to_die < p->time_to_sleep - p->time_slept - chk_int)
-			sft_margn = (p->time_to_sleep - p->time_slept - chk_int) * 0.9;
-		if (get_timestamp() - p->last_meal_time <= sft_margn)
-		{
-			eat(p);
-			log_activity(p, "is sleeping");
-		}
-		usleep(chk_int);
-		p->time_slept += chk_int;
-		if (p->time_to_sleep - p->time_slept < chk_int)
-			chk_int = p->time_to_sleep - p->time_slept;
+		if (p->now - p->last_meal_time
+			>= sleep_margin(p, deadline - p->now, chk_int))
+			deadline += eat_break(p);
+		next = p->now + chk_int;
+		if (next > deadline)
+			next = deadline;
+		sleep_until(&p->clock, next, p->sleep_stats);
 		verify_death(p);
 	}
-	p->time_slept = 0;
-	log_activity(p, "is thinking");
+	log_activity(p, ACT_THINK);
+}
+
+/**
+ * With an odd number of philos the start stagger alone does not hold: a
+ * philo just out of his sleep takes the forks another was about to get,
+ * who ends up starving. So, after his sleep, a philo thinks until
+ * 2 * time_to_eat - time_to_sleep have passed (if that is positive) before
+ * reaching for the pool: the table settles in three rounds of meals, every
+ * philo eating once every eat + sleep + think.
+ */
+static void	think(t_philo *p)
+{
+	long long	think_us;
+
+	if (p->shm->n % 2 == 0)
+		return ;
+	think_us = (2LL * p->config.time_to_eat - p->config.time_to_sleep)
+		* 1000;
+	if (think_us <= 0)
+		return ;
+	sleep_until(&p->clock, p->now + think_us, p->sleep_stats);
+	verify_death(p);
 }
 
 /**
@@ -144,9 +152,12 @@ static void	erratic_sleep(t_philo *p)
  *
  * Even if here we have lesser problems of conflicts (being forks all piled)
  * in order to lower the risk of deadlocks and we scrumble up the starting:
- * each philo with an even ID will start by sleeping, the others by eating.
+ * each philo with an even ID will start by sleeping, the others by eating;
+ * with an odd number of philos they think before eating again (see think).
  *
- * The function will also check for the philo's death using `verify_death`.
+ * The function will also check for the philo's death using `verify_death`,
+ * his watchdog thread does the same on its own, on time, whatever he is
+ * doing (see watchdog).
  *
  * @param arg A pointer to the `t_philo` created in the main program.
  */
@@ -155,25 +166,21 @@ void	*philo_cycle(void *arg)
 	t_philo	*philo;
 
 	philo = (t_philo *)arg;
-	philo->semaphores.log_sem = sem_open("log_sem", 0);
-	philo->semaphores.simulation_sem = sem_open("sim_sem", 0);
-	philo->semaphores.fork_pool = sem_open("fork_pool", 0);
-	sem_wait(philo->semaphores.simulation_sem);
-	philo->last_meal_time = get_timestamp();
-	philo->time_slept = 0;
+	philo->last_meal_time = philo->shm->t0;
+	philo->now = philo->last_meal_time;
+	atomic_store(&philo->deadline,
+		philo->now + philo->config.time_to_die * 1000LL);
 	philo->times_eaten = 0;
+	pthread_mutex_init(&philo->pool_lock, NULL);
+	if (!watchdog_start(philo))
+		exit(0);
+	if (philo->id % 2 == 0)
+		erratic_sleep(philo);
 	while (1)
 	{
-		if (philo->id % 2 == 0)
-		{
-			erratic_sleep(philo);
-			eat(philo);
-		}
-		if (philo->id % 2 != 0)
-		{
-			eat(philo);
-			erratic_sleep(philo);
-		}
+		eat(philo);
+		erratic_sleep(philo);
+		think(philo);
 		verify_death(philo);
 	}
 	return (NULL);
@@ -6,7 +6,7 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/18 16:02:38 by amarabin          #+#    #+#             */
-/*   Updated: 2023/09/22 23:29:29 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,61 +14,91 @@
 
 /**
  * We verify if the simulation has been stopped by anther thread.
- * If so we release the currenly held resources and we exit before
- * to log the event
+ * If so we release the currenly held resources (through the strategy's put,
+ * which knows what the philo holds) and we exit before to log the event
  */
-void	verify_simulation_status(t_philo *philo, pthread_mutex_t *fork1,
-		pthread_mutex_t *fork2)
+void	verify_simulation_status(t_philo *philo)
 {
-	pthread_mutex_lock(&philo->shared_resources->simulation_mutex);
-	if (!philo->shared_resources->simulation_active)
+	if (!simulation_running(philo->shared_resources))
 	{
-		pthread_mutex_unlock(&philo->shared_resources->simulation_mutex);
-		if (fork1)
-			pthread_mutex_unlock(fork1);
-		if (fork2)
-			pthread_mutex_unlock(fork2);
-		pthread_exit(NULL);
+		philo->shared_resources->strategy.put(philo);
+		engine_exit(philo);
 	}
-	pthread_mutex_unlock(&philo->shared_resources->simulation_mutex);
 }
 
 /**
- * We write a log on screen.
- * The reason for using a mutex is that at high speed the screen can become
- * jumbled.
+ * We log an activity.
+ * The event is only queued in the philo's own ring: the formatting and the
+ * actual write on screen happen in the log writer thread, so a slow stdout
+ * never stalls a philo.
+ * The time logged is philo->now, the one read by the last verify_death: the
+ * line carries the same instant the decision was taken on.
+ * With --stats-file the counters of the philo are published at the same
+ * time.
  */
-void	log_activity(t_philo *philo, const char *activity,
-		pthread_mutex_t *fork1, pthread_mutex_t *fork2)
+void	log_activity(t_philo *philo, int activity)
 {
-	verify_simulation_status(philo, fork1, fork2);
-	pthread_mutex_lock(&(philo->shared_resources->log_mutex));
-	printf("%lld %d %s\n", get_timestamp(), philo->id, activity);
-	pthread_mutex_unlock(&(philo->shared_resources->log_mutex));
+	verify_simulation_status(philo);
+	ring_push(philo->ring, philo->now / 1000, philo->id, activity);
+	if (philo->stats_slot)
+		stats_publish(philo, activity);
 }
 
 /**
- * We verify if ((get_timestamp()-philo->last_meal_time) >= philo->time_to_die)
- * if so we update the state of the simulation and we release each resource
- * keept by the thread.
- * The reason for using a mutex is that the flag simulation_active in a multi
- * threaded environment can really be different for every thread. This is a way
- * of having a safe access to it.
+ * We read the clock once for the whole transition, caching it in philo->now,
+ * and verify if (now - philo->last_meal_time) >= time_to_die
+ * (times are kept in microseconds, time_to_die is in milliseconds).
+ * if so we end the simulation and we release each resource keept by the
+ * thread.
+ * The death monitor catches the philos that can not get here (e.g. blocked
+ * on a fork); this check makes sure a philo never acts past his deadline.
  */
-void	verify_death(t_philo *philo, pthread_mutex_t *fork1,
-		pthread_mutex_t *fork2)
+void	verify_death(t_philo *philo)
 {
-	verify_simulation_status(philo, fork1, fork2);
-	if ((get_timestamp() - philo->last_meal_time) >= philo->time_to_die)
+	verify_simulation_status(philo);
+	philo->now = clock_now_us(&philo->shared_resources->clock);
+	if ((philo->now - philo->last_meal_time)
+		>= philo->config->time_to_die * 1000LL)
 	{
-		pthread_mutex_lock(&(philo->shared_resources->simulation_mutex));
-		philo->shared_resources->simulation_active = 0;
-		pthread_mutex_unlock(&(philo->shared_resources->simulation_mutex));
-		if (fork1)
-			pthread_mutex_unlock(fork1);
-		if (fork2)
-			pthread_mutex_unlock(fork2);
-		log_activity(philo, "died", NULL, NULL);
-		pthread_exit(NULL);
+		stop_simulation(philo->shared_resources, philo->ring, philo->now,
+			philo->id);
+		philo->shared_resources->strategy.put(philo);
+		engine_exit(philo);
 	}
 }
+
+/**
+ * Time since the last meal past which the philo interrupts his sleep to go
+ * eat: 90% of time_to_die, or 90% of what is left of the sleep (minus one
+ * check interval) when that is longer.
+ * All values in microseconds.
+ */
+long long	sleep_margin(t_philo *p, long long left, long long chk_int)
+{
+	if (p->config->time_to_die * 1000LL < left - chk_int)
+		return ((left - chk_int) * 0.9);
+	return (p->config->time_to_die * 900LL);
+}
+
+/**
+ * With an odd number of philos the parity stagger alone does not hold: a
+ * philo just out of his sleep takes the fork his neighbour was about to
+ * get, and the one next to them starves. So, after his sleep, a philo
+ * thinks until 2 * time_to_eat - time_to_sleep have passed (if that is
+ * positive) before reaching for the forks: the table settles in three
+ * rounds of meals, every philo eating once every eat + sleep + think.
+ */
+void	philo_think(t_philo *p)
+{
+	long long	think_us;
+
+	if (!p->shared_resources->strategy.stagger
+		|| p->shared_resources->n_philos % 2 == 0)
+		return ;
+	think_us = (2LL * p->config->time_to_eat - p->config->time_to_sleep)
+		* 1000;
+	if (think_us <= 0)
+		return ;
+	engine_sleep_until(p, p->now + think_us);
+	verify_death(p);
+}
@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_cycle_utils_bonus.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:31:48 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:11:27 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * We log the line of philo at time now: it goes in the next position of the
+ * log ring, shared by every process, that the parent prints (see
+ * log_writer). Taking a position is a single atomic add, nobody ever waits
+ * on a semaphore to log; only with the ring full (the parent fell behind)
+ * we wait for our slot to be free, rather than dropping the line.
+ * The event is published by the store on seq: one written by a process
+ * killed half way never is, and the parent skips it at the end.
+ * With --stats-file the counters of the philo are published as well.
+ */
+void	log_event(t_philo *philo, long long now, int activity)
+{
+	t_log_slot		*slot;
+	unsigned int	pos;
+
+	pos = atomic_fetch_add_explicit(&philo->shm->log_head, 1,
+			memory_order_relaxed);
+	slot = &philo->shm->log[pos & (LOG_RING_SIZE - 1)];
+	while (atomic_load_explicit(&slot->seq, memory_order_acquire) != pos)
+		usleep(LOG_POLL_US);
+	slot->timestamp = now / 1000;
+	slot->id = philo->id;
+	slot->activity = activity;
+	atomic_store_explicit(&slot->seq, pos + 1, memory_order_release);
+	if (philo->stats_file)
+		stats_publish(philo, activity);
+}
+
+/**
+ * The time logged is philo->now, the one read by the last verify_death.
+ */
+void	log_activity(t_philo *philo, int activity)
+{
+	log_event(philo, philo->now, activity);
+}
+
+/**
+ * We read the clock once for the whole transition, caching it in philo->now,
+ * and verify if (now - philo->last_meal_time) >= philo->config.time_to_die
+ * (times are kept in microseconds, time_to_die is in milliseconds).
+ * if so the philo dies (see philo_die). While he is blocked on the fork
+ * pool it is his watchdog that finds out.
+ */
+void	verify_death(t_philo *philo)
+{
+	philo->now = clock_now_us(&philo->clock);
+	if ((philo->now - philo->last_meal_time)
+		>= philo->config.time_to_die * 1000LL)
+		philo_die(philo, philo->now);
+}
+
+/**
+ * Time since the last meal past which the philo interrupts his sleep to go
+ * eat: 90% of time_to_die, or 90% of what is left of the sleep (minus one
+ * check interval) when that is longer.
+ * All values in microseconds.
+ */
+long long	sleep_margin(t_philo *p, long long left, long long chk_int)
+{
+	if (p->config.time_to_die * 1000LL < left - chk_int)
+		return ((left - chk_int) * 0.9);
+	return (p->config.time_to_die * 900LL);
+}
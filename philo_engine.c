@@ -0,0 +1,79 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_engine.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:05:33 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * The worker the calling thread is, NULL when it is not running fibers
+ * (threads engine, log writer, death monitor, main).
+ */
+t_worker	**current_worker(void)
+{
+	static _Thread_local t_worker	*worker;
+
+	return (&worker);
+}
+
+/**
+ * How many workers or shards: as many as given, by default one per cpu, and
+ * never more than the philos.
+ */
+static int	per_cpu(int given, int n_philos)
+{
+	long	cpus;
+	int		n;
+
+	n = given;
+	if (!n)
+	{
+		cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		n = 1;
+		if (cpus > 1)
+			n = cpus;
+	}
+	if (n > n_philos)
+		n = n_philos;
+	return (n);
+}
+
+/**
+ * Chooses how the philos are run (--engine).
+ * With fibers the workers default to one per cpu, and never outnumber the
+ * philos. A fiber must never block its worker, so the forks are given the
+ * adaptive lock, the only one that waits by parking (see park_wait).
+ * With shards the processes are counted the same way, the philos being
+ * threads in them.
+ * Virtual time runs on fibers, on a single worker.
+ * Philo threads and fibers get stack_size bytes of stack: thousands of
+ * them do not need (nor should reserve) the default 8MB each.
+ */
+void	engine_configure(t_shared *shared, int n_philos)
+{
+	memset(&shared->engine, 0, sizeof(t_engine));
+	if (shared->opts.virtual_time)
+	{
+		shared->opts.engine = ENGINE_FIBERS;
+		shared->opts.workers = 1;
+		shared->opts.clock_source = CLK_VIRTUAL;
+	}
+	shared->engine.stack_size = THREAD_STACK;
+	if (shared->opts.engine == ENGINE_FIBERS)
+		shared->engine.stack_size = FIBER_STACK;
+	if (shared->opts.stack_kb)
+		shared->engine.stack_size = (size_t)shared->opts.stack_kb * 1024;
+	if (shared->opts.engine == ENGINE_SHARDS)
+		shared->engine.n_shards = per_cpu(shared->opts.shards, n_philos);
+	if (shared->opts.engine != ENGINE_FIBERS)
+		return ;
+	shared->engine.n_workers = per_cpu(shared->opts.workers, n_philos);
+	shared->opts.fork_lock = LOCK_ADAPTIVE;
+}
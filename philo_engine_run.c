@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_engine_run.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:51:16 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 03:25:20 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Creates the threads of the philos from up to (excluded) to.
+ * Return: 0 if one could not be created.
+ */
+int	start_threads(t_shared *shared, int from, int to)
+{
+	pthread_attr_t	attr;
+	int				i;
+	int				ret;
+
+	i = from - 1;
+	while (++i < to)
+	{
+		pthread_attr_init(&attr);
+		pthread_attr_setstacksize(&attr, shared->engine.stack_size);
+		placement_attr(shared, &attr, i, shared->n_philos);
+		ret = pthread_create(&shared->engine.threads[i], &attr, philo_cycle,
+				&shared->philos[i]);
+		pthread_attr_destroy(&attr);
+		if (ret)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * Blocks the calling philo thread, or worker, until engine_go.
+ * A fiber only ever runs once its worker went through here.
+ */
+void	engine_wait_start(t_shared *shared)
+{
+	while (!atomic_load_explicit(&shared->started, memory_order_acquire))
+		futex_wait(&shared->started, 0, shared->engine.n_shards != 0, -1);
+}
+
+/**
+ * Once every thread exists: gives all the philos the same t0 as their last
+ * meal (and deadline), lets them all go at once, then starts the death
+ * monitor, which watches their deadlines until the simulation stops.
+ * With virtual time the worker is also the monitor, it must find the
+ * deadlines in its heap as soon as it runs (see virtual_advance).
+ * Return: 0 if the monitor could not be started.
+ */
+int	engine_go(t_shared *shared)
+{
+	long long	t0;
+	int			i;
+
+	t0 = clock_now_us(&shared->clock);
+	i = -1;
+	while (++i < shared->n_philos)
+	{
+		shared->philos[i].last_meal_time = t0;
+		atomic_store_explicit(&shared->philos[i].deadline,
+			t0 + shared->philos[i].config->time_to_die * 1000LL,
+			memory_order_relaxed);
+	}
+	if (shared->opts.virtual_time)
+		monitor_init(shared);
+	shared->t0 = t0;
+	atomic_store_explicit(&shared->started, 1, memory_order_release);
+	futex_wake(&shared->started, INT_MAX, shared->engine.n_shards != 0);
+	if (!shared->opts.virtual_time
+		&& pthread_create(&shared->engine.monitor, NULL, death_monitor,
+			shared))
+		return (0);
+	return (1);
+}
+
+/**
+ * Starts the philos on the engine chosen with --engine. Every thread waits
+ * at the start gate (see engine_wait_start) until engine_go: nobody gets a
+ * head start on the table.
+ * With threads, each philosopher gets one: until the simulation ends it
+ * lives it's own life, nobody waits for it before engine_stop. Threads
+ * (philos or workers) are pinned as --placement says.
+ * With fibers only the workers are started, the fibers are already queued
+ * on them (see fibers_init).
+ * With shards the threads are started by the shard processes (see
+ * shards_start).
+ * Return: 1 on success, 0 if a thread could not be created.
+ */
+int	engine_start(t_shared *shared)
+{
+	shared->spawn_start = clock_now_us(&shared->clock);
+	if (shared->engine.n_workers)
+		return (fibers_start(shared));
+	if (shared->engine.n_shards)
+		return (shards_start(shared));
+	return (start_threads(shared, 0, shared->n_philos));
+}
+
+/**
+ * Called once the simulation ended. The philo threads leave by themselves
+ * (those asleep are woken up by the stop, see engine_sleep_until) and are
+ * joined, so that nothing uses the table any more once we return; the
+ * workers are woken up and joined, the shard processes reaped, as the
+ * monitor joined.
+ */
+void	engine_stop(t_shared *shared)
+{
+	int	i;
+
+	if (shared->engine.n_workers)
+		fibers_stop(shared);
+	if (shared->engine.n_shards)
+		shards_stop(shared);
+	i = 0;
+	while (!shared->engine.n_workers && !shared->engine.n_shards
+		&& i < shared->n_philos)
+		pthread_join(shared->engine.threads[i++], NULL);
+	if (!shared->opts.virtual_time)
+		pthread_join(shared->engine.monitor, NULL);
+}
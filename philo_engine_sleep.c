@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_engine_sleep.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:18:29 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:18:29 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef __linux__
+
+/**
+ * sleep_until for a philo thread, cut short as soon as the simulation
+ * stops: the wait is a futex wait on simulation_active, which
+ * stop_simulation wakes up, and the last clock->spin_us are spun as in
+ * sleep_until.
+ * Return: the overshoot, -1 if the simulation stopped first.
+ */
+static long long	thread_sleep_until(t_philo *p, long long deadline)
+{
+	t_shared	*shared;
+	long long	now;
+
+	shared = p->shared_resources;
+	now = clock_now_us(&shared->clock);
+	while (deadline - now > shared->clock.spin_us
+		&& simulation_running(shared))
+	{
+		futex_wait(&shared->simulation_active, 1,
+			shared->engine.n_shards != 0,
+			deadline - now - shared->clock.spin_us);
+		now = clock_now_us(&shared->clock);
+	}
+	while (now < deadline && simulation_running(shared))
+		now = clock_now_us(&shared->clock);
+	if (now < deadline)
+		return (-1);
+	sleep_stats_record(&p->sleep_stats, now - deadline);
+	return (now - deadline);
+}
+
+#else
+
+/**
+ * Without futexes the wait is not cut short: the philo sees the stop once
+ * awake.
+ */
+static long long	thread_sleep_until(t_philo *p, long long deadline)
+{
+	return (sleep_until(&p->shared_resources->clock, deadline,
+			&p->sleep_stats));
+}
+
+#endif
+
+/**
+ * sleep_until for a philo. A thread leaves as soon as the simulation stops
+ * (see thread_sleep_until): nobody waits for the end of his meal or sleep
+ * to join him. A fiber does not sleep: it files itself in the
+ * timers of its worker and gives the worker back, which resumes it once
+ * the clock reads deadline (with the same final spin as sleep_until, when
+ * there is nothing else to run).
+ */
+void	engine_sleep_until(t_philo *p, long long deadline)
+{
+	t_worker	*worker;
+	t_fiber		*fiber;
+	long long	overshoot;
+
+	worker = *current_worker();
+	if (!worker)
+		overshoot = thread_sleep_until(p, deadline);
+	else
+	{
+		fiber = worker->current;
+		heap_push(&worker->timers, deadline, fiber - worker->engine->fibers);
+		swapcontext(&fiber->ctx, &worker->sched);
+		overshoot = clock_now_us(&p->shared_resources->clock) - deadline;
+		sleep_stats_record(&p->sleep_stats, overshoot);
+	}
+	if (overshoot < 0)
+		verify_simulation_status(p);
+	if (p->hists)
+		hist_record(&p->hists[HIST_OVERSHOOT], overshoot);
+}
+
+/**
+ * pthread_exit for a philo: a fiber is marked done and never resumed.
+ */
+void	engine_exit(t_philo *p)
+{
+	t_worker	*worker;
+
+	(void)p;
+	worker = *current_worker();
+	if (!worker)
+		pthread_exit(NULL);
+	worker->current->done = 1;
+	setcontext(&worker->sched);
+}
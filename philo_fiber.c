@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_fiber.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:38:52 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+static void	fiber_entry(void)
+{
+	philo_cycle((*current_worker())->current->philo);
+}
+
+/**
+ * Gives every worker a contiguous block of philos (neighbours mostly share
+ * a worker, and so their forks), a timer heap as large as its block and
+ * one event ring: its fibers run one at a time on it, so they make a
+ * single producer, and each of them logs right after reading the clock,
+ * so the ring stays in time order.
+ */
+static int	init_workers(t_shared *shared, t_engine *engine)
+{
+	int	i;
+	int	per_worker;
+
+	engine->workers = malloc(engine->n_workers * sizeof(t_worker));
+	if (!engine->workers)
+		return (0);
+	memset(engine->workers, 0, engine->n_workers * sizeof(t_worker));
+	per_worker = shared->n_philos / engine->n_workers + 1;
+	i = -1;
+	while (++i < engine->n_workers)
+	{
+		engine->workers[i].engine = engine;
+		engine->workers[i].shared = shared;
+		atomic_init(&engine->workers[i].inbox, NULL);
+		atomic_init(&engine->workers[i].bell, 0);
+		engine->workers[i].timers.nodes = malloc(per_worker
+				* sizeof(t_heap_node));
+		if (!engine->workers[i].timers.nodes)
+			return (0);
+	}
+	return (1);
+}
+
+/**
+ * Fiber i: philo i on the worker whose block he falls in, logging in the
+ * ring of that worker, queued ready to start philo_cycle on its own slice
+ * of the stacks.
+ */
+static void	init_fiber(t_shared *shared, t_engine *engine, int i)
+{
+	t_fiber	*fiber;
+
+	fiber = &engine->fibers[i];
+	memset(fiber, 0, sizeof(t_fiber));
+	fiber->philo = &shared->philos[i];
+	fiber->worker = (long long)i * engine->n_workers / shared->n_philos;
+	shared->philos[i].ring = &shared->rings[fiber->worker];
+	getcontext(&fiber->ctx);
+	fiber->ctx.uc_stack.ss_sp = engine->stacks + i * engine->stack_size;
+	fiber->ctx.uc_stack.ss_size = engine->stack_size;
+	fiber->ctx.uc_link = &engine->workers[fiber->worker].sched;
+	makecontext(&fiber->ctx, fiber_entry, 0);
+	run_push(&engine->workers[fiber->worker], fiber);
+}
+
+/**
+ * One fiber per philo, all their stacks in a single mapping (only the
+ * pages a fiber actually touches are ever backed by memory), each fiber
+ * queued on its worker (see init_fiber).
+ */
+int	fibers_init(t_shared *shared)
+{
+	t_engine	*engine;
+	int			i;
+
+	engine = &shared->engine;
+	engine->fibers = malloc(shared->n_philos * sizeof(t_fiber));
+	engine->stacks_len = (size_t)shared->n_philos * engine->stack_size;
+	engine->stacks = mmap(NULL, engine->stacks_len, PROT_READ | PROT_WRITE,
+			MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (!engine->fibers || engine->stacks == MAP_FAILED
+		|| !init_workers(shared, engine))
+		return (0);
+	i = -1;
+	while (++i < shared->n_philos)
+		init_fiber(shared, engine, i);
+	return (1);
+}
+
+/**
+ * Once the simulation stopped: wakes the idle workers up so that they see
+ * it, waits for them and releases everything the engine owns.
+ */
+void	fibers_stop(t_shared *shared)
+{
+	t_engine	*engine;
+	int			i;
+
+	engine = &shared->engine;
+	i = -1;
+	while (++i < engine->n_workers)
+	{
+		atomic_fetch_add_explicit(&engine->workers[i].bell, 1,
+			memory_order_release);
+		futex_wake(&engine->workers[i].bell, 1, 0);
+	}
+	i = -1;
+	while (++i < engine->n_workers)
+	{
+		pthread_join(engine->workers[i].thread, NULL);
+		free(engine->workers[i].timers.nodes);
+	}
+	munmap(engine->stacks, engine->stacks_len);
+	free(engine->workers);
+	free(engine->fibers);
+}
@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_fork.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:55:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:49:56 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * A pshared fork is used from two processes: its mutex is process shared,
+ * and robust, so that a shard dying with it held does not take its
+ * neighbour shard with it (see fork_mutex_lock).
+ */
+void	fork_init(t_fork *fork, int kind, int pshared)
+{
+	pthread_mutexattr_t	attr;
+
+	memset(fork, 0, sizeof(t_fork));
+	fork->kind = kind;
+	fork->pshared = pshared;
+	pthread_mutexattr_init(&attr);
+	if (pshared)
+	{
+		pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+		pthread_mutexattr_setrobust(&attr, PTHREAD_MUTEX_ROBUST);
+	}
+	pthread_mutex_init(&fork->mutex, &attr);
+	pthread_mutexattr_destroy(&attr);
+	atomic_init(&fork->next_ticket, 0);
+	atomic_init(&fork->now_serving, 0);
+	atomic_init(&fork->tail, NULL);
+	atomic_init(&fork->state, 0);
+	atomic_init(&fork->grants.turn, 0);
+	fork->last_node = -1;
+}
+
+void	fork_destroy(t_fork *fork)
+{
+	pthread_mutex_destroy(&fork->mutex);
+	free(fork->grants.bits);
+}
+
+/**
+ * Takes the fork with the lock it was initialized with.
+ * node is the MCS queue node of the caller: a philo holds at most two forks
+ * at once, the first one taken with his qnodes[0], the second with
+ * qnodes[1]. The other locks ignore it.
+ * The backends account their own spins and parks and tell if they had to
+ * wait at all; the counters are updated once the fork is ours, so they need
+ * no atomics.
+ * id is the philo taking the fork: in replay he first waits for his turn,
+ * and every grant is accounted for record and replay once it is made.
+ * A fork between two shards linked by a socket is not locked, its token is
+ * asked for (see link_take).
+ */
+void	fork_lock(t_fork *fork, t_qnode *node, int id)
+{
+	static int	(*const lock[])(t_fork *, t_qnode *) = {fork_mutex_lock,
+		fork_ticket_lock, fork_mcs_lock, fork_adaptive_lock};
+
+	if (fork->grants.mode == GRANTS_REPLAY)
+		grants_wait(fork, id);
+	if ((fork->remote && link_take(fork))
+		|| (!fork->remote && lock[fork->kind](fork, node)))
+		fork->stats.contended++;
+	fork->stats.acquired++;
+	if (fork->grants.mode != GRANTS_OFF)
+		grants_take(fork, id);
+}
+
+void	fork_unlock(t_fork *fork)
+{
+	static void	(*const unlock[])(t_fork *) = {fork_mutex_unlock,
+		fork_ticket_unlock, fork_mcs_unlock, fork_adaptive_unlock};
+
+	if (fork->remote)
+		link_put(fork);
+	else
+		unlock[fork->kind](fork);
+}
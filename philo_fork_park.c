@@ -0,0 +1,97 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_fork_park.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:59:03 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:43:11 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * The plain pthread mutex. A failed trylock tells us we are going to wait,
+ * the blocking lock that follows counts as a park.
+ * A fork between two shards may be left held by a shard that died: we get
+ * it, and make it usable again.
+ */
+int	fork_mutex_lock(t_fork *fork, t_qnode *node)
+{
+	int	ret;
+	int	waited;
+
+	(void)node;
+	waited = 0;
+	ret = pthread_mutex_trylock(&fork->mutex);
+	if (ret == EBUSY)
+	{
+		ret = pthread_mutex_lock(&fork->mutex);
+		fork->stats.parks++;
+		waited = 1;
+	}
+	if (ret == EOWNERDEAD)
+		pthread_mutex_consistent(&fork->mutex);
+	return (waited);
+}
+
+void	fork_mutex_unlock(t_fork *fork)
+{
+	pthread_mutex_unlock(&fork->mutex);
+}
+
+/**
+ * Past the spinning phase: mark the fork as wanted by sleepers (state 2)
+ * and sleep on the futex until we are the one that finds it free.
+ */
+static int	adaptive_park(t_fork *fork, long long spins)
+{
+	long long	parks;
+
+	parks = 0;
+	while (atomic_exchange_explicit(&fork->state, 2, memory_order_acquire))
+	{
+		park_wait(&fork->state, 2, fork->pshared, -1);
+		parks++;
+	}
+	fork->stats.spins += spins;
+	fork->stats.parks += parks;
+	return (1);
+}
+
+/**
+ * Adaptive lock: a fork is held for time_to_eat, so a short spin only pays
+ * off when the holder is about to put it down; after ADAPTIVE_SPINS turns
+ * the waiter parks on a futex (the parking lot, on a fiber) and leaves the
+ * cpu to the others.
+ */
+int	fork_adaptive_lock(t_fork *fork, t_qnode *node)
+{
+	int			free_state;
+	long long	spins;
+
+	(void)node;
+	spins = 0;
+	free_state = 0;
+	while (!atomic_compare_exchange_weak_explicit(&fork->state, &free_state,
+			1, memory_order_acquire, memory_order_relaxed))
+	{
+		if (++spins >= ADAPTIVE_SPINS)
+			return (adaptive_park(fork, spins));
+		cpu_relax();
+		free_state = 0;
+	}
+	fork->stats.spins += spins;
+	return (spins != 0);
+}
+
+/**
+ * Only a state of 2 means someone may be asleep on the futex.
+ */
+void	fork_adaptive_unlock(t_fork *fork)
+{
+	if (atomic_exchange_explicit(&fork->state, 0, memory_order_release) == 2)
+		park_wake(&fork->state, 1, fork->pshared);
+}
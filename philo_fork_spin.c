@@ -0,0 +1,106 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_fork_spin.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:57:40 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 16:57:40 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * One turn of busy waiting, yielding every LOCK_YIELD_SPINS turns: with
+ * more philos than cpus the thread we wait for may well be the one that
+ * needs our cpu.
+ */
+static void	spin_wait(long long *spins)
+{
+	(*spins)++;
+	if (*spins % LOCK_YIELD_SPINS == 0)
+		sched_yield();
+	else
+		cpu_relax();
+}
+
+/**
+ * Ticket lock: each caller draws a ticket and waits for it to be served,
+ * the fork goes to the waiters in strict FIFO order.
+ */
+int	fork_ticket_lock(t_fork *fork, t_qnode *node)
+{
+	unsigned int	ticket;
+	long long		spins;
+
+	(void)node;
+	spins = 0;
+	ticket = atomic_fetch_add_explicit(&fork->next_ticket, 1,
+			memory_order_relaxed);
+	while (atomic_load_explicit(&fork->now_serving, memory_order_acquire)
+		!= ticket)
+		spin_wait(&spins);
+	fork->stats.spins += spins;
+	return (spins != 0);
+}
+
+void	fork_ticket_unlock(t_fork *fork)
+{
+	atomic_store_explicit(&fork->now_serving,
+		atomic_load_explicit(&fork->now_serving, memory_order_relaxed) + 1,
+		memory_order_release);
+}
+
+/**
+ * MCS lock: FIFO like the ticket lock, but each waiter spins on the locked
+ * flag of its own node, so a release touches only the next waiter's cache
+ * line instead of every waiter's.
+ */
+int	fork_mcs_lock(t_fork *fork, t_qnode *node)
+{
+	t_qnode		*prev;
+	long long	spins;
+
+	spins = 0;
+	atomic_store_explicit(&node->next, NULL, memory_order_relaxed);
+	atomic_store_explicit(&node->locked, 1, memory_order_relaxed);
+	prev = atomic_exchange_explicit(&fork->tail, node, memory_order_acq_rel);
+	if (prev)
+	{
+		atomic_store_explicit(&prev->next, node, memory_order_release);
+		while (atomic_load_explicit(&node->locked, memory_order_acquire))
+			spin_wait(&spins);
+	}
+	fork->holder = node;
+	fork->stats.spins += spins;
+	return (prev != NULL);
+}
+
+/**
+ * If nobody queued behind us the tail goes back to NULL; if someone is
+ * swapping himself in right now we wait for him to link his node, then
+ * hand him the fork.
+ */
+void	fork_mcs_unlock(t_fork *fork)
+{
+	t_qnode	*node;
+	t_qnode	*next;
+
+	node = fork->holder;
+	next = atomic_load_explicit(&node->next, memory_order_acquire);
+	if (!next)
+	{
+		if (atomic_compare_exchange_strong_explicit(&fork->tail, &node, NULL,
+				memory_order_release, memory_order_relaxed))
+			return ;
+		node = fork->holder;
+		while (!next)
+		{
+			cpu_relax();
+			next = atomic_load_explicit(&node->next, memory_order_acquire);
+		}
+	}
+	atomic_store_explicit(&next->locked, 0, memory_order_release);
+}
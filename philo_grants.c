@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_grants.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:04:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Every fork has two users: the philo it is the left fork of is users[0],
+ * the one it is the right fork of users[1].
+ * With Chandy-Misra the fork locks only guard the messages of the forks,
+ * taken as many times as the philos poll: there is no grant order to speak
+ * of and the trace stays off.
+ * Return: 0 if the trace to replay can not be loaded.
+ */
+int	grants_init(t_shared *shared)
+{
+	int	mode;
+	int	i;
+
+	mode = shared->opts.grants;
+	if (shared->opts.strategy == STRAT_CHANDY_MISRA)
+		mode = GRANTS_OFF;
+	i = -1;
+	while (++i < shared->n_philos)
+	{
+		shared->forks[i].grants.mode = mode;
+		shared->forks[i].grants.active = &shared->simulation_active;
+		shared->philos[i].left_fork->grants.users[0] = shared->philos[i].id;
+		shared->philos[i].right_fork->grants.users[1] = shared->philos[i].id;
+	}
+	if (mode != GRANTS_REPLAY)
+		return (1);
+	if (grants_load(shared))
+		return (1);
+	printf("Invalid trace: %s\n", shared->opts.trace_path);
+	return (0);
+}
+
+static int	grantee(t_grants *grants, int turn)
+{
+	return (grants->users[(grants->bits[turn / 8] >> (turn % 8)) & 1]);
+}
+
+/**
+ * Replay: blocks until the next recorded grant of the fork is for philo id.
+ * Once the trace is over (or the simulation stopped) the fork is free for
+ * all.
+ */
+void	grants_wait(t_fork *fork, int id)
+{
+	int	turn;
+
+	turn = atomic_load_explicit(&fork->grants.turn, memory_order_acquire);
+	while (turn < fork->grants.len && grantee(&fork->grants, turn) != id
+		&& atomic_load_explicit(fork->grants.active, memory_order_acquire))
+	{
+		park_wait(&fork->grants.turn, turn, fork->pshared,
+			STRATEGY_POLL_US);
+		turn = atomic_load_explicit(&fork->grants.turn, memory_order_acquire);
+	}
+}
+
+/**
+ * Doubles the bits of a recording fork (64 bytes at first, zeroed).
+ * Return: 0 if the allocation failed, which ends the recording of the fork.
+ */
+static int	grow_bits(t_grants *g)
+{
+	unsigned char	*bits;
+
+	bits = realloc(g->bits, g->cap * 2 + 64);
+	if (!bits)
+	{
+		g->mode = GRANTS_OFF;
+		return (0);
+	}
+	memset(bits + g->cap, 0, g->cap + 64);
+	g->bits = bits;
+	g->cap = g->cap * 2 + 64;
+	return (1);
+}
+
+/**
+ * Called by the new holder, under the fork's lock: records the grant (one
+ * bit, see grow_bits), or in replay hands the turn to the next grantee.
+ */
+void	grants_take(t_fork *fork, int id)
+{
+	t_grants	*g;
+	int			turn;
+
+	g = &fork->grants;
+	turn = atomic_load_explicit(&g->turn, memory_order_relaxed);
+	if (g->mode == GRANTS_REPLAY && turn < g->len)
+	{
+		atomic_store_explicit(&g->turn, turn + 1, memory_order_release);
+		park_wake(&g->turn, INT_MAX, fork->pshared);
+		return ;
+	}
+	if (g->mode != GRANTS_RECORD)
+		return ;
+	if (g->len / 8 >= g->cap && !grow_bits(g))
+		return ;
+	g->bits[g->len / 8] |= (id == g->users[1]) << (g->len % 8);
+	g->len++;
+}
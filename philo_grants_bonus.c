@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_grants_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:31:05 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:02:46 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+static size_t	pool_trace_size(void)
+{
+	return (sizeof(t_pool_trace) + POOL_TRACE_CAP * sizeof(int));
+}
+
+/**
+ * Maps the pool trace before any fork, so that every child shares it (only
+ * the pages actually written get memory). In replay the trace is loaded
+ * here: after the header (see trace_create) the number of grants, as a
+ * long long, then the ids, one int each.
+ * Return: 0 if the mapping fails or the trace to replay can not be read.
+ */
+int	pool_trace_init(t_philo *f_tmpl, int n_philos)
+{
+	t_pool_trace	*t;
+	int				fd;
+	int				ok;
+
+	if (f_tmpl->opts.grants == GRANTS_OFF)
+		return (1);
+	t = mmap(NULL, pool_trace_size(), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+	if (t == MAP_FAILED)
+		return (0);
+	f_tmpl->pool_trace = t;
+	atomic_init(&t->cursor, 0);
+	t->mode = f_tmpl->opts.grants;
+	if (t->mode != GRANTS_REPLAY)
+		return (1);
+	fd = trace_open(f_tmpl->opts.trace_path, TRACE_POOL, n_philos);
+	ok = fd >= 0 && read_all(fd, &t->len, sizeof(t->len)) && t->len >= 0
+		&& t->len <= POOL_TRACE_CAP
+		&& read_all(fd, t->ids, t->len * sizeof(int));
+	if (fd >= 0)
+		close(fd);
+	if (!ok)
+		printf("Invalid trace: %s\n", f_tmpl->opts.trace_path);
+	return (ok);
+}
+
+/**
+ * Replay: waits until the next recorded grant is ours, checking on our
+ * life meanwhile (nobody else would).
+ */
+static void	wait_turn(t_philo *p, t_pool_trace *t)
+{
+	int	cursor;
+
+	cursor = atomic_load_explicit(&t->cursor, memory_order_acquire);
+	while (cursor < t->len && t->ids[cursor] && t->ids[cursor] != p->id)
+	{
+		futex_wait(&t->cursor, cursor, 1, POOL_POLL_US);
+		verify_death(p);
+		cursor = atomic_load_explicit(&t->cursor, memory_order_acquire);
+	}
+}
+
+/**
+ * Takes a fork from the pool. With --record the grant is written down
+ * (a single atomic increment and a store in the shared mapping), with
+ * --replay the philo first waits for his turn and then passes it on.
+ * Each wait is bounded by the deadline of the philo, who then checks on
+ * his life himself (see pool_acquire).
+ */
+void	pool_take(t_philo *p)
+{
+	t_pool_trace	*t;
+	int				i;
+
+	t = p->pool_trace;
+	if (t && t->mode == GRANTS_REPLAY)
+		wait_turn(p, t);
+	while (!pool_acquire(p))
+		verify_death(p);
+	if (!t)
+		return ;
+	i = atomic_fetch_add_explicit(&t->cursor, 1, memory_order_acq_rel);
+	if (t->mode == GRANTS_RECORD && i < POOL_TRACE_CAP)
+		t->ids[i] = p->id;
+	if (t->mode == GRANTS_REPLAY)
+		futex_wake(&t->cursor, INT_MAX, 1);
+}
+
+/**
+ * Called by the parent once the children are gone.
+ */
+void	pool_trace_save(t_philo *f_tmpl, int n_philos)
+{
+	t_pool_trace	*t;
+	long long		len;
+	int				fd;
+
+	t = f_tmpl->pool_trace;
+	if (!t)
+		return ;
+	if (t->mode == GRANTS_RECORD)
+	{
+		len = atomic_load(&t->cursor);
+		if (len > POOL_TRACE_CAP)
+			len = POOL_TRACE_CAP;
+		fd = trace_create(f_tmpl->opts.trace_path, TRACE_POOL, n_philos);
+		if (fd < 0 || !write_all(fd, &len, sizeof(len))
+			|| !write_all(fd, t->ids, len * sizeof(int)))
+			printf("Could not save the trace: %s\n", f_tmpl->opts.trace_path);
+		if (fd >= 0)
+			close(fd);
+	}
+	munmap(t, pool_trace_size());
+}
@@ -0,0 +1,67 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_grants_io.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:15:48 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 20:15:48 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Trace layout after the header (see trace_create): for every fork, the
+ * number of grants recorded (a long long) followed by one bit per grant,
+ * rounded up to the byte.
+ * Return: 1 on success.
+ */
+int	grants_save(t_shared *shared)
+{
+	t_grants	*g;
+	int			fd;
+	int			ok;
+	int			i;
+
+	fd = trace_create(shared->opts.trace_path, TRACE_FORKS, shared->n_philos);
+	if (fd < 0)
+		return (0);
+	ok = 1;
+	i = -1;
+	while (ok && ++i < shared->n_philos)
+	{
+		g = &shared->forks[i].grants;
+		ok = write_all(fd, &g->len, sizeof(g->len))
+			&& write_all(fd, g->bits, (g->len + 7) / 8);
+	}
+	close(fd);
+	return (ok);
+}
+
+int	grants_load(t_shared *shared)
+{
+	t_grants	*g;
+	int			fd;
+	int			ok;
+	int			i;
+
+	fd = trace_open(shared->opts.trace_path, TRACE_FORKS, shared->n_philos);
+	if (fd < 0)
+		return (0);
+	ok = 1;
+	i = -1;
+	while (ok && ++i < shared->n_philos)
+	{
+		g = &shared->forks[i].grants;
+		ok = read_all(fd, &g->len, sizeof(g->len)) && g->len >= 0
+			&& g->len < INT_MAX;
+		g->cap = (g->len + 7) / 8;
+		if (ok)
+			g->bits = malloc(g->cap + 1);
+		ok = ok && g->bits && read_all(fd, g->bits, g->cap);
+	}
+	close(fd);
+	return (ok);
+}
@@ -0,0 +1,68 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_heap.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:12:31 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 10:12:31 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+static void	swap_nodes(t_heap_node *a, t_heap_node *b)
+{
+	t_heap_node	tmp;
+
+	tmp = *a;
+	*a = *b;
+	*b = tmp;
+}
+
+/**
+ * Binary min-heap of (key, idx) couples, nodes[0] always holds the smallest
+ * key. The storage is allocated once by the owner, so none of these
+ * functions allocate.
+ */
+void	heap_sift_down(t_heap *heap, int i)
+{
+	int	child;
+
+	while (1)
+	{
+		child = 2 * i + 1;
+		if (child >= heap->size)
+			return ;
+		if (child + 1 < heap->size
+			&& heap->nodes[child + 1].key < heap->nodes[child].key)
+			child++;
+		if (heap->nodes[i].key <= heap->nodes[child].key)
+			return ;
+		swap_nodes(&heap->nodes[i], &heap->nodes[child]);
+		i = child;
+	}
+}
+
+void	heap_push(t_heap *heap, long long key, int idx)
+{
+	int	i;
+
+	i = heap->size++;
+	heap->nodes[i].key = key;
+	heap->nodes[i].idx = idx;
+	while (i > 0 && heap->nodes[(i - 1) / 2].key > heap->nodes[i].key)
+	{
+		swap_nodes(&heap->nodes[(i - 1) / 2], &heap->nodes[i]);
+		i = (i - 1) / 2;
+	}
+}
+
+void	heap_pop(t_heap *heap)
+{
+	if (heap->size <= 0)
+		return ;
+	heap->nodes[0] = heap->nodes[--heap->size];
+	heap_sift_down(heap, 0);
+}
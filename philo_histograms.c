@@ -0,0 +1,72 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_histograms.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 21:52:37 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:43:11 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * One set of histograms per thread that records (see t_shared), so that
+ * recording is a plain increment: each philo points to the set of the
+ * thread it runs on, the fibers of a worker all share the worker's.
+ * Without --histograms nothing is allocated and philo->hists stays NULL,
+ * which is all the recording sites check. They are mapped as the arena is,
+ * the shard processes record in them as well.
+ * Return: 0 if the allocation failed.
+ */
+int	histograms_init(t_shared *shared)
+{
+	int	set;
+	int	i;
+
+	if (!shared->opts.histograms)
+		return (1);
+	shared->n_hists = shared->n_philos + 1;
+	if (shared->engine.n_workers)
+		shared->n_hists = shared->engine.n_workers + 1;
+	shared->hists = table_map(shared,
+			shared->n_hists * HIST_KINDS * sizeof(t_hist));
+	if (!shared->hists)
+		return (0);
+	i = -1;
+	while (++i < shared->n_philos)
+	{
+		set = i;
+		if (shared->engine.n_workers)
+			set = shared->engine.fibers[i].worker;
+		shared->philos[i].hists = &shared->hists[set * HIST_KINDS];
+	}
+	return (1);
+}
+
+/**
+ * Merges the histograms of every thread, once they are all gone, and
+ * prints their percentiles on stderr (microseconds).
+ */
+void	histograms_report(t_shared *shared)
+{
+	static const char	*names[] = {"first fork wait_us",
+		"second fork wait_us", "sleep overshoot_us", "death report lag_us"};
+	t_hist				*sum;
+	int					kind;
+	int					set;
+
+	if (!shared->hists)
+		return ;
+	kind = -1;
+	while (++kind < HIST_KINDS)
+	{
+		sum = &shared->hists[kind];
+		set = 0;
+		while (++set < shared->n_hists)
+			hist_merge(sum, &shared->hists[set * HIST_KINDS + kind]);
+		hist_print(names[kind], sum);
+	}
+}
@@ -0,0 +1,126 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_link.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 02:47:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * The link between shards a and b, made on first use: a SOCK_SEQPACKET
+ * socket pair (every send is one message, received whole, in order) and
+ * its stats, one set per end.
+ * Return: NULL if the socket pair could not be made.
+ */
+static t_link	*link_get(t_shared *shared, int a, int b)
+{
+	t_engine	*e;
+	t_link		*link;
+	int			i;
+
+	e = &shared->engine;
+	i = -1;
+	while (++i < e->n_links)
+		if ((e->links[i].shards[0] == a && e->links[i].shards[1] == b)
+			|| (e->links[i].shards[0] == b && e->links[i].shards[1] == a))
+			return (&e->links[i]);
+	link = &e->links[e->n_links];
+	if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, link->fds)
+		|| pthread_mutex_init(&link->lock, NULL)
+		|| pthread_cond_init(&link->cond, NULL))
+		return (NULL);
+	link->shards[0] = a;
+	link->shards[1] = b;
+	link->stats = &e->link_stats[2 * e->n_links++];
+	link->stats[0].from = a;
+	link->stats[0].to = b;
+	link->stats[1].from = b;
+	link->stats[1].to = a;
+	return (link);
+}
+
+/**
+ * Sets up lf, the shard side of fork f: owned first by the shard of the
+ * philo it is the left one of, passed along the link to the shard of the
+ * philo before.
+ * Return: 0 if the link could not be made.
+ */
+static int	lfork_init(t_shared *shared, t_lfork *lf, int f)
+{
+	lf->owner = shard_of(shared, f);
+	lf->link = link_get(shared, lf->owner, shard_of(shared,
+				(f + shared->n_philos - 1) % shared->n_philos));
+	if (!lf->link)
+		return (0);
+	lf->shared = shared;
+	lf->fork = f;
+	shared->forks[f].remote = lf;
+	return (1);
+}
+
+/**
+ * --fork-link=socket, before the shards are forked: every fork between two
+ * shards (one per shard, the left one of its first philo) is passed along
+ * the link between them, instead of being locked in shared memory (see
+ * fork_lock). The token starts on the side of the philo the fork is the
+ * left one of.
+ * links and lforks are private memory: each shard gets its own copy when
+ * forked. Only the stats are shared, for the parent to report.
+ * Return: 0 on failure.
+ */
+int	link_setup(t_shared *shared)
+{
+	t_engine	*e;
+	t_lfork		*lf;
+	int			f;
+
+	e = &shared->engine;
+	e->links = calloc(e->n_shards, sizeof(t_link));
+	e->lforks = calloc(e->n_shards, sizeof(t_lfork));
+	e->link_stats = table_map(shared, 2 * e->n_shards * sizeof(t_link_stats));
+	if (!e->links || !e->lforks || !e->link_stats)
+		return (0);
+	lf = e->lforks;
+	f = -1;
+	while (++f < shared->n_philos)
+		if (shard_boundary(shared, f) && !lfork_init(shared, lf++, f))
+			return (0);
+	return (1);
+}
+
+/**
+ * Run by shard s once forked (by the parent with s = -1): keeps only its
+ * end of its links, takes the tokens it starts with, and starts the link
+ * thread that answers the other side.
+ * Return: 0 if the link thread could not be started.
+ */
+int	link_attach(t_shared *shared, int s, pthread_t *thread)
+{
+	t_link	*link;
+	int		i;
+
+	i = -1;
+	while (++i < shared->engine.n_links)
+	{
+		link = &shared->engine.links[i];
+		link->side = -1;
+		if (link->shards[0] == s || link->shards[1] == s)
+			link->side = (link->shards[1] == s);
+		if (link->side != 0)
+			close(link->fds[0]);
+		if (link->side != 1)
+			close(link->fds[1]);
+	}
+	i = -1;
+	while (++i < shared->engine.n_shards)
+		shared->engine.lforks[i].have = (shared->engine.lforks[i].owner == s);
+	if (s < 0)
+		return (1);
+	return (pthread_create(thread, NULL, link_thread, shared) == 0);
+}
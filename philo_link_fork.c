@@ -0,0 +1,104 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_link_fork.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:21:30 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:21:30 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Sends the batch of the link (under its lock) as a single message.
+ */
+void	link_flush(t_link *link)
+{
+	t_link_stats	*stats;
+
+	if (!link->out.n)
+		return ;
+	stats = &link->stats[link->side];
+	if (send(link->fds[link->side], &link->out, offsetof(t_link_msg, ops)
+			+ link->out.n * sizeof(t_link_op), MSG_NOSIGNAL) > 0)
+	{
+		stats->msgs_out++;
+		stats->ops_out += link->out.n;
+	}
+	link->out.n = 0;
+}
+
+/**
+ * Queues a request or a grant of fork on the link's batch (under its
+ * lock), sent once full or at the next link_flush.
+ */
+void	link_push(t_link *link, int fork, int op)
+{
+	link->out.ops[link->out.n].fork = fork;
+	link->out.ops[link->out.n++].op = op;
+	if (link->out.n == LINK_BATCH)
+		link_flush(link);
+}
+
+/**
+ * fork_lock for a fork between two shards: asks the other side for the
+ * token if we do not have it, and waits until it is ours and free. Once
+ * the simulation stopped we leave without it (busy stays 0, link_put does
+ * nothing): the link thread wakes us up on its way out.
+ * Return: 1 if we had to wait.
+ */
+int	link_take(t_fork *fork)
+{
+	t_lfork	*lf;
+	t_link	*link;
+	int		waited;
+
+	lf = fork->remote;
+	link = lf->link;
+	waited = 0;
+	pthread_mutex_lock(&link->lock);
+	while ((!lf->have || lf->busy) && simulation_running(lf->shared))
+	{
+		waited = 1;
+		if (!lf->have && !lf->requested)
+		{
+			lf->requested = 1;
+			lf->sent_at = clock_now_us(&lf->shared->clock);
+			link->stats[link->side].requests++;
+			link_push(link, lf->fork, LINK_REQUEST);
+			link_flush(link);
+		}
+		pthread_cond_wait(&link->cond, &link->lock);
+	}
+	if (lf->have && !lf->busy)
+		lf->busy = 1;
+	pthread_mutex_unlock(&link->lock);
+	return (waited);
+}
+
+/**
+ * Puts the fork down, handing it straight to the other side if it asked
+ * for it meanwhile.
+ */
+void	link_put(t_fork *fork)
+{
+	t_lfork	*lf;
+
+	lf = fork->remote;
+	pthread_mutex_lock(&lf->link->lock);
+	if (lf->busy)
+	{
+		lf->busy = 0;
+		if (lf->wanted)
+		{
+			lf->wanted = 0;
+			lf->have = 0;
+			link_push(lf->link, lf->fork, LINK_GRANT);
+			link_flush(lf->link);
+		}
+	}
+	pthread_mutex_unlock(&lf->link->lock);
+}
@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_link_io.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 02:47:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * A request is granted at once if the token is here and free, otherwise
+ * the fork is granted when put down (see link_put). A grant gives us the
+ * token, and the round trip of our request.
+ */
+static void	link_op(t_shared *shared, t_link *link, t_link_op *op)
+{
+	t_lfork	*lf;
+
+	if (op->fork < 0 || op->fork >= shared->n_philos
+		|| !shared->forks[op->fork].remote)
+		return ;
+	lf = shared->forks[op->fork].remote;
+	if (op->op == LINK_REQUEST)
+	{
+		if (lf->have && !lf->busy)
+		{
+			lf->have = 0;
+			link_push(link, lf->fork, LINK_GRANT);
+		}
+		else
+			lf->wanted = 1;
+		return ;
+	}
+	lf->have = 1;
+	lf->requested = 0;
+	hist_record(&link->stats[link->side].rtt,
+		clock_now_us(&shared->clock) - lf->sent_at);
+	pthread_cond_broadcast(&link->cond);
+}
+
+/**
+ * Reads every message waiting on the link, then answers all the requests
+ * they carried at once: the grants go out as a single batch.
+ * Return: 0 once the other side closed its end.
+ */
+static int	link_receive(t_shared *shared, t_link *link)
+{
+	t_link_msg	msg;
+	ssize_t		len;
+	int			i;
+
+	pthread_mutex_lock(&link->lock);
+	len = recv(link->fds[link->side], &msg, sizeof(msg), MSG_DONTWAIT);
+	while (len >= (ssize_t)offsetof(t_link_msg, ops))
+	{
+		link->stats[link->side].msgs_in++;
+		link->stats[link->side].ops_in += msg.n;
+		i = 0;
+		while (i < msg.n && i < LINK_BATCH)
+			link_op(shared, link, &msg.ops[i++]);
+		len = recv(link->fds[link->side], &msg, sizeof(msg), MSG_DONTWAIT);
+	}
+	link_flush(link);
+	pthread_mutex_unlock(&link->lock);
+	return (len < 0 && errno == EAGAIN);
+}
+
+/**
+ * Waits up to LINK_POLL_MS for messages on the links of the shard (fds,
+ * one entry per link, -1 when not ours or closed).
+ */
+static void	link_poll(t_shared *shared, struct pollfd *fds)
+{
+	int	i;
+
+	if (poll(fds, shared->engine.n_links, LINK_POLL_MS) <= 0)
+		return ;
+	i = -1;
+	while (++i < shared->engine.n_links)
+	{
+		if (fds[i].fd >= 0 && fds[i].revents
+			&& !link_receive(shared, &shared->engine.links[i]))
+			fds[i].fd = -1;
+	}
+}
+
+/**
+ * The pollfds of the links of the shard, one entry per link, -1 when not
+ * ours.
+ * Return: NULL if out of memory.
+ */
+static struct pollfd	*link_fds(t_shared *shared)
+{
+	struct pollfd	*fds;
+	t_link			*link;
+	int				i;
+
+	fds = malloc(shared->engine.n_links * sizeof(struct pollfd));
+	i = -1;
+	while (fds && ++i < shared->engine.n_links)
+	{
+		link = &shared->engine.links[i];
+		fds[i].fd = -1;
+		if (link->side >= 0)
+			fds[i].fd = link->fds[link->side];
+		fds[i].events = POLLIN;
+	}
+	return (fds);
+}
+
+/**
+ * The link thread of a shard: answers the other sides of its links until
+ * the simulation stops, then wakes up whoever still waits for a token.
+ */
+void	*link_thread(void *arg)
+{
+	t_shared		*shared;
+	struct pollfd	*fds;
+	int				i;
+
+	shared = (t_shared *)arg;
+	fds = link_fds(shared);
+	if (!fds)
+		stop_simulation(shared, NULL, 0, 0);
+	while (fds && simulation_running(shared))
+		link_poll(shared, fds);
+	i = -1;
+	while (++i < shared->engine.n_links)
+	{
+		pthread_mutex_lock(&shared->engine.links[i].lock);
+		pthread_cond_broadcast(&shared->engine.links[i].cond);
+		pthread_mutex_unlock(&shared->engine.links[i].lock);
+	}
+	free(fds);
+	return (NULL);
+}
@@ -0,0 +1,151 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_log.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 10:27:04 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Pushes an event in the philo's own ring.
+ * Only the owning thread moves head and only the writer thread moves tail, so
+ * no lock is needed: the release store on head publishes the event to the
+ * writer, the release store on tail gives the slot back to the philo.
+ * If the writer fell behind and the ring is full we wait for it instead of
+ * dropping the line.
+ */
+void	ring_push(t_ring *ring, long long timestamp, int id, int activity)
+{
+	unsigned int	head;
+	t_event			*event;
+
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	while (head - atomic_load_explicit(&ring->tail, memory_order_acquire)
+		>= RING_SIZE)
+		usleep(LOG_POLL_US);
+	event = &ring->events[head & (RING_SIZE - 1)];
+	event->timestamp = timestamp;
+	event->id = id;
+	event->activity = activity;
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+}
+
+/**
+ * Returns 1 and fills key with the timestamp of the oldest pending event of
+ * the ring, 0 if the ring is empty.
+ */
+static int	ring_peek(t_ring *ring, long long *key)
+{
+	unsigned int	tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	if (tail == atomic_load_explicit(&ring->head, memory_order_acquire))
+		return (0);
+	*key = ring->events[tail & (RING_SIZE - 1)].timestamp;
+	return (1);
+}
+
+/**
+ * Pops the oldest event of ring into the sink. "died" is flushed at once
+ * (and, with --histograms, how late it came out past the philo's deadline
+ * is recorded).
+ * Return: 1 if it was the "died" line.
+ */
+static int	print_event(t_shared *shared, t_ring *ring)
+{
+	t_event			event;
+	unsigned int	tail;
+
+	tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+	event = ring->events[tail & (RING_SIZE - 1)];
+	atomic_store_explicit(&ring->tail, tail + 1, memory_order_release);
+	sink_line(&shared->sink, event.timestamp, event.id,
+		activity_name(event.activity));
+	if (event.activity != ACT_DIED)
+		return (0);
+	sink_flush(&shared->sink);
+	if (shared->hists)
+		hist_record(&shared->hists[(shared->n_hists - 1) * HIST_KINDS
+			+ HIST_DEATH_LAG], clock_now_us(&shared->clock)
+			- atomic_load(&shared->philos[event.id - 1].deadline));
+	return (1);
+}
+
+/**
+ * One merge pass over every ring.
+ * The non empty rings are put in a min-heap keyed on the timestamp of their
+ * oldest event, then we keep printing the top of the heap and re-keying its
+ * ring until all of them are drained. Each ring is already sorted, so this is
+ * a k-way merge costing O(log n) per line instead of a scan of every ring.
+ * Return: 1 once the "died" line has been printed (nothing may follow it).
+ */
+static int	drain_round(t_shared *shared, t_heap *heap)
+{
+	int			i;
+	long long	key;
+	t_ring		*ring;
+
+	heap->size = 0;
+	i = -1;
+	while (++i < shared->n_rings)
+		if (ring_peek(&shared->rings[i], &key))
+			heap_push(heap, key, i);
+	while (heap->size > 0)
+	{
+		ring = &shared->rings[heap->nodes[0].idx];
+		if (print_event(shared, ring))
+			return (1);
+		if (ring_peek(ring, &heap->nodes[0].key))
+			heap_sift_down(heap, 0);
+		else
+			heap_pop(heap);
+	}
+	return (0);
+}
+
+/**
+ * The only thread that writes on stdout.
+ * Philos never wait on it: they push in their rings and go on, while here we
+ * periodically merge the rings in timestamp order into the sink, which turns
+ * a whole batch of lines into a single write(2), but for "died" (see
+ * print_event).
+ * The simulation state is sampled before the drain, so when it reads as
+ * stopped the pass that follows is guaranteed to see every event (the "died"
+ * one included) pushed before the stop.
+ * Past that the philos may still push a line or two on their way out: those
+ * are dropped, and never left to fill a ring, until sim_run (once every
+ * philo is gone) sets writer_stop.
+ */
+void	*log_writer(void *arg)
+{
+	t_shared	*shared;
+	int			running;
+	int			i;
+
+	shared = (t_shared *)arg;
+	while (1)
+	{
+		running = simulation_running(shared);
+		if (drain_round(shared, &shared->log_heap) || !running)
+			break ;
+		sink_tick(&shared->sink, clock_now_us(&shared->clock) / 1000);
+		usleep(LOG_POLL_US);
+	}
+	sink_flush(&shared->sink);
+	while (!atomic_load_explicit(&shared->writer_stop, memory_order_acquire))
+	{
+		i = -1;
+		while (++i < shared->n_rings)
+			atomic_store_explicit(&shared->rings[i].tail, atomic_load_explicit(
+					&shared->rings[i].head, memory_order_acquire),
+				memory_order_release);
+		usleep(LOG_POLL_US);
+	}
+	return (NULL);
+}
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_log_bonus.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 06:02:44 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 06:02:44 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * Prints the events of the ring, in the order their positions were taken,
+ * up to the first one not published yet: its process is still writing it.
+ * Unless final, when every child is gone: such an event will never be, it
+ * is skipped. Each slot is given back (seq moved one lap ahead) as soon as
+ * it is read. Once "died" is out (flushed at once) nothing else is printed,
+ * the events are only discarded.
+ */
+static void	drain(t_shm *shm, int final)
+{
+	t_log_slot		*slot;
+	unsigned int	head;
+	unsigned int	seq;
+
+	head = atomic_load_explicit(&shm->log_head, memory_order_acquire);
+	while (shm->log_tail != head)
+	{
+		slot = &shm->log[shm->log_tail & (LOG_RING_SIZE - 1)];
+		seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		if (seq != shm->log_tail + 1 && !final)
+			return ;
+		if (seq == shm->log_tail + 1 && !shm->done)
+		{
+			sink_line(&shm->sink, slot->timestamp, slot->id,
+				activity_name(slot->activity));
+			shm->done = slot->activity == ACT_DIED;
+		}
+		if (shm->done)
+			sink_flush(&shm->sink);
+		atomic_store_explicit(&slot->seq, shm->log_tail + LOG_RING_SIZE,
+			memory_order_release);
+		shm->log_tail++;
+	}
+}
+
+/**
+ * The only writer on stdout, a thread of the parent: every LOG_POLL_US it
+ * drains the ring into the sink, which turns a whole batch of lines into a
+ * single write(2) (and never lets one wait more than --log-flush-ms).
+ * Stopped by log_stop once every child is gone, it drains what they left.
+ */
+static void	*log_writer(void *arg)
+{
+	t_philo	*f_tmpl;
+	t_shm	*shm;
+
+	f_tmpl = (t_philo *)arg;
+	shm = f_tmpl->shm;
+	while (!atomic_load_explicit(&shm->writer_stop, memory_order_acquire))
+	{
+		drain(shm, 0);
+		sink_tick(&shm->sink, clock_now_us(&f_tmpl->clock) / 1000);
+		usleep(LOG_POLL_US);
+	}
+	drain(shm, 1);
+	sink_flush(&shm->sink);
+	return (NULL);
+}
+
+/**
+ * Frees every slot of the ring for the first lap (seq = position) and
+ * starts the writer, before any child exists.
+ * Return: 0 if the sink or the thread could not be made.
+ */
+int	log_start(t_philo *f_tmpl)
+{
+	t_shm	*shm;
+	int		i;
+
+	shm = f_tmpl->shm;
+	i = -1;
+	while (++i < LOG_RING_SIZE)
+		atomic_init(&shm->log[i].seq, i);
+	if (!sink_init(&shm->sink, STDOUT_FILENO, f_tmpl->opts.log_batch,
+			f_tmpl->opts.log_flush_ms))
+		return (0);
+	if (pthread_create(&shm->writer, NULL, log_writer, f_tmpl))
+	{
+		free(shm->sink.buf);
+		return (0);
+	}
+	return (1);
+}
+
+/**
+ * Called once every child has been killed and reaped.
+ */
+void	log_stop(t_philo *f_tmpl)
+{
+	atomic_store_explicit(&f_tmpl->shm->writer_stop, 1, memory_order_release);
+	pthread_join(f_tmpl->shm->writer, NULL);
+	free(f_tmpl->shm->sink.buf);
+}
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_monitor.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 15:22:40 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 01:40:06 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Deadlines only ever move forward (a meal pushes them later), so the key
+ * stored in the heap is a lower bound of the real one. When the top turns
+ * out to be stale we refresh its key and let it sink: a philo that ate
+ * costs O(log n) the next time it reaches the top, and not before.
+ * Return: the index of the philo with the earliest up to date deadline.
+ */
+static int	earliest(t_shared *shared, t_heap *heap)
+{
+	long long	deadline;
+	t_philo		*philo;
+
+	while (1)
+	{
+		philo = &shared->philos[heap->nodes[0].idx];
+		deadline = atomic_load_explicit(&philo->deadline,
+				memory_order_acquire);
+		if (deadline == heap->nodes[0].key)
+			return (heap->nodes[0].idx);
+		heap->nodes[0].key = deadline;
+		heap_sift_down(heap, 0);
+	}
+}
+
+void	monitor_init(t_shared *shared)
+{
+	t_heap	*heap;
+	int		i;
+
+	heap = &shared->monitor_heap;
+	heap->size = 0;
+	i = -1;
+	while (++i < shared->n_philos)
+		heap_push(heap, atomic_load(&shared->philos[i].deadline), i);
+}
+
+/**
+ * If the earliest deadline is past at `now`, the philo it belongs to did
+ * not eat in time: he is dead at now.
+ * Return: the earliest deadline, -1 once the death is declared.
+ */
+long long	monitor_check(t_shared *shared, long long now)
+{
+	t_heap	*heap;
+	int		i;
+
+	heap = &shared->monitor_heap;
+	i = earliest(shared, heap);
+	if (now < heap->nodes[0].key)
+		return (heap->nodes[0].key);
+	stop_simulation(shared, &shared->rings[shared->n_rings - 1], now,
+		shared->philos[i].id);
+	return (-1);
+}
+
+/**
+ * The only thread in charge of noticing deaths that the philos can not see
+ * by themselves, typically while blocked waiting for a fork.
+ * Every philo publishes in `deadline` when he is going to starve; here we
+ * keep them in a min-heap and sleep exactly until the earliest one. If by
+ * then the philo did not eat (his deadline did not move) he is dead.
+ * The report latency is then the one of sleep_until, whatever the contention
+ * on the forks.
+ * The bulk of the wait is on the end event, so that the monitor leaves as
+ * soon as the simulation stops for any other reason; only the final spin of
+ * sleep_until is not interruptible.
+ * With --virtual-time there is no such thread: the worker makes the same
+ * checks every time it moves the clock (see virtual_advance).
+ */
+void	*death_monitor(void *arg)
+{
+	t_shared	*shared;
+	long long	key;
+
+	shared = (t_shared *)arg;
+	monitor_init(shared);
+	while (simulation_running(shared))
+	{
+		key = monitor_check(shared, clock_now_us(&shared->clock));
+		if (key >= 0 && !wait_end(shared, key - shared->clock.spin_us))
+			sleep_until(&shared->clock, key, NULL);
+	}
+	return (NULL);
+}
@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_park.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:12:47 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * The parking lot: the futex of the fibers. A fiber waiting on a word is
+ * queued in the bucket the address hashes to, guarded by a spinlock held
+ * only for a few instructions.
+ */
+static t_bucket	*bucket_lock(t_engine *engine, atomic_int *word)
+{
+	t_bucket	*bucket;
+
+	bucket = &engine->buckets[((size_t)word >> 2) % PARK_BUCKETS];
+	while (atomic_flag_test_and_set_explicit(&bucket->lock,
+			memory_order_acquire))
+		cpu_relax();
+	return (bucket);
+}
+
+/**
+ * Queues fiber, waiting on word, at the tail of the (locked) bucket.
+ */
+static void	enqueue(t_bucket *bucket, t_fiber *fiber, atomic_int *word)
+{
+	fiber->wait_word = word;
+	fiber->next = NULL;
+	if (bucket->tail)
+		bucket->tail->next = fiber;
+	else
+		bucket->head = fiber;
+	bucket->tail = fiber;
+}
+
+/**
+ * futex_wait for whoever may run on a fiber: wait while *word == val.
+ * pshared is for the threads, as in futex_wait: the words other shard
+ * processes may wake (fibers never run in shards).
+ * The word is checked under the bucket lock, and a waker changes it before
+ * taking that same lock, so a wake up can not slip between the check and
+ * the queueing.
+ * A fiber waits without timeout: it has no death to check on by itself
+ * (the monitor does) and when the simulation stops its worker just leaves
+ * it where it is.
+ */
+void	park_wait(atomic_int *word, int val, int pshared, long long timeout_us)
+{
+	t_worker	*worker;
+	t_bucket	*bucket;
+	t_fiber		*fiber;
+
+	worker = *current_worker();
+	if (!worker)
+	{
+		futex_wait(word, val, pshared, timeout_us);
+		return ;
+	}
+	bucket = bucket_lock(worker->engine, word);
+	if (atomic_load_explicit(word, memory_order_acquire) != val)
+	{
+		atomic_flag_clear_explicit(&bucket->lock, memory_order_release);
+		return ;
+	}
+	fiber = worker->current;
+	enqueue(bucket, fiber, word);
+	atomic_flag_clear_explicit(&bucket->lock, memory_order_release);
+	swapcontext(&fiber->ctx, &worker->sched);
+}
+
+/**
+ * Takes out of the (locked) bucket up to n of the fibers waiting on word,
+ * oldest first.
+ * Return: the fibers taken, linked through next.
+ */
+static t_fiber	*unlink_waiters(t_bucket *bucket, atomic_int *word, int n)
+{
+	t_fiber	**link;
+	t_fiber	*prev;
+	t_fiber	*fiber;
+	t_fiber	*woken;
+
+	woken = NULL;
+	prev = NULL;
+	link = &bucket->head;
+	while (*link && n)
+	{
+		fiber = *link;
+		if (fiber->wait_word != word)
+		{
+			prev = fiber;
+			link = &fiber->next;
+			continue ;
+		}
+		*link = fiber->next;
+		if (bucket->tail == fiber)
+			bucket->tail = prev;
+		fiber->next = woken;
+		woken = fiber;
+		n--;
+	}
+	return (woken);
+}
+
+/**
+ * futex_wake for whoever may run on a fiber: makes runnable up to n of the
+ * fibers waiting on word.
+ */
+void	park_wake(atomic_int *word, int n, int pshared)
+{
+	t_worker	*worker;
+	t_bucket	*bucket;
+	t_fiber		*woken;
+	t_fiber		*fiber;
+
+	worker = *current_worker();
+	if (!worker)
+	{
+		futex_wake(word, n, pshared);
+		return ;
+	}
+	bucket = bucket_lock(worker->engine, word);
+	woken = unlink_waiters(bucket, word, n);
+	atomic_flag_clear_explicit(&bucket->lock, memory_order_release);
+	while (woken)
+	{
+		fiber = woken;
+		woken = woken->next;
+		fiber_ready(worker->engine, fiber);
+	}
+}
@@ -0,0 +1,59 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_placement.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:48:30 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef __linux__
+
+/**
+ * Pins the thread about to be created with attr, the idx-th of total that
+ * share the table in contiguous ranges: each range on one cpu (core), or
+ * on all the cpus of one node (node). Neighbours, who share forks, share
+ * the cpu or the node but at the edges of the ranges.
+ */
+void	placement_attr(t_shared *shared, pthread_attr_t *attr, int idx,
+		int total)
+{
+	t_topology	*topo;
+	cpu_set_t	set;
+	int			node;
+	int			i;
+
+	topo = &shared->topology;
+	if (shared->opts.placement == PLACE_NONE || !topo->n_cpus)
+		return ;
+	CPU_ZERO(&set);
+	if (shared->opts.placement == PLACE_CORE)
+		CPU_SET(topo->cpus[(long long)idx * topo->n_cpus / total], &set);
+	else
+	{
+		node = topo->nodes[(long long)idx * topo->n_nodes / total];
+		i = -1;
+		while (++i < topo->n_cpus)
+			if (topo->node_of[topo->cpus[i]] == node)
+				CPU_SET(topo->cpus[i], &set);
+	}
+	pthread_attr_setaffinity_np(attr, sizeof(set), &set);
+}
+
+#else
+
+void	placement_attr(t_shared *shared, pthread_attr_t *attr, int idx,
+		int total)
+{
+	(void)shared;
+	(void)attr;
+	(void)idx;
+	(void)total;
+}
+
+#endif
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_placement_bind.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:17:17 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:17:17 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#ifdef PHILO_HAS_NUMA
+# include <numa.h>
+#endif
+
+#ifdef PHILO_HAS_NUMA
+
+/**
+ * With --placement=node and libnuma (built with -DPHILO_HAS_NUMA -lnuma),
+ * binds the pages of a table of n elements of size bytes, split in the same
+ * contiguous ranges as the threads, to the node of each range (the pages
+ * across two ranges go to the latter). It must be called before the table
+ * is first touched.
+ */
+void	placement_bind(t_shared *shared, void *base, size_t size, int n)
+{
+	t_topology	*topo;
+	uintptr_t	from;
+	uintptr_t	to;
+	uintptr_t	page;
+	int			j;
+
+	topo = &shared->topology;
+	if (shared->opts.placement != PLACE_NODE || topo->n_nodes < 2)
+		return ;
+	page = sysconf(_SC_PAGESIZE);
+	j = -1;
+	while (++j < topo->n_nodes)
+	{
+		from = (uintptr_t)base + (long long)j * n / topo->n_nodes * size;
+		to = (uintptr_t)base + (long long)(j + 1) * n / topo->n_nodes * size;
+		from &= ~(page - 1);
+		to = (to + page - 1) & ~(page - 1);
+		numa_tonode_memory((void *)from, to - from, topo->nodes[j]);
+	}
+}
+
+#elif defined(__linux__)
+
+/**
+ * Writes to every page of [range[0], range[1]), from a thread pinned to
+ * one node: each page is allocated where it is first touched.
+ */
+static void	*touch_pages(void *arg)
+{
+	char	**range;
+	char	*p;
+	long	page;
+
+	range = arg;
+	page = sysconf(_SC_PAGESIZE);
+	p = range[0];
+	while (p < range[1])
+	{
+		*(volatile char *)p = 0;
+		p += page;
+	}
+	return (NULL);
+}
+
+/**
+ * Without libnuma, the pages of the table (fresh ones, never touched yet)
+ * are placed by first touch: for each node a thread pinned to its cpus
+ * (see placement_attr) touches the pages of its range, the last range
+ * first so that the pages across two ranges go to the latter, as with
+ * libnuma.
+ */
+void	placement_bind(t_shared *shared, void *base, size_t size, int n)
+{
+	t_topology		*topo;
+	pthread_attr_t	attr;
+	pthread_t		thread;
+	char			*range[2];
+	int				j;
+
+	topo = &shared->topology;
+	if (shared->opts.placement != PLACE_NODE || topo->n_nodes < 2)
+		return ;
+	j = topo->n_nodes;
+	while (--j >= 0)
+	{
+		range[0] = (char *)(((uintptr_t)base + (long long)j * n
+					/ topo->n_nodes * size) & ~(sysconf(_SC_PAGESIZE) - 1));
+		range[1] = (char *)base + (long long)(j + 1) * n / topo->n_nodes
+			* size;
+		pthread_attr_init(&attr);
+		placement_attr(shared, &attr, j, topo->n_nodes);
+		if (!pthread_create(&thread, &attr, touch_pages, range))
+			pthread_join(thread, NULL);
+		pthread_attr_destroy(&attr);
+	}
+}
+
+#else
+
+/**
+ * Without numa support the pages of the tables land where the thread
+ * first touching them runs.
+ */
+void	placement_bind(t_shared *shared, void *base, size_t size, int n)
+{
+	(void)shared;
+	(void)base;
+	(void)size;
+	(void)n;
+}
+
+#endif
@@ -0,0 +1,51 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_placement_handoff.c                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:17:17 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:17:17 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef __linux__
+
+/**
+ * Called with --stats once a philo holds both his forks: a fork last held
+ * on another node than the one we run on has just crossed the interconnect
+ * (its cache lines with it).
+ */
+void	placement_handoff(t_philo *p)
+{
+	t_fork	*forks[2];
+	int		cpu;
+	int		node;
+	int		i;
+
+	cpu = sched_getcpu();
+	node = 0;
+	if (cpu >= 0 && cpu < PLACE_MAX_CPUS)
+		node = p->shared_resources->topology.node_of[cpu];
+	forks[0] = p->first_fork;
+	forks[1] = p->second_fork;
+	i = -1;
+	while (++i < 2)
+	{
+		if (forks[i]->last_node >= 0 && forks[i]->last_node != node)
+			forks[i]->stats.cross_node++;
+		forks[i]->last_node = node;
+	}
+}
+
+#else
+
+void	placement_handoff(t_philo *p)
+{
+	(void)p;
+}
+
+#endif
@@ -0,0 +1,107 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_placement_topology.c                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:17:17 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:17:17 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef __linux__
+
+/**
+ * Reads one "a" or "a-b" item of a sysfs cpu list at s[*i] (and the comma
+ * after it) into [from, to].
+ */
+static void	parse_range(const char *s, int *i, int *from, int *to)
+{
+	*from = 0;
+	while (s[*i] >= '0' && s[*i] <= '9')
+		*from = *from * 10 + s[(*i)++] - '0';
+	*to = *from;
+	if (s[*i] == '-')
+	{
+		(*i)++;
+		*to = 0;
+		while (s[*i] >= '0' && s[*i] <= '9')
+			*to = *to * 10 + s[(*i)++] - '0';
+	}
+	if (s[*i] == ',')
+		(*i)++;
+}
+
+/**
+ * Reads from sysfs the cpus of a numa node: they are on that node (without
+ * numa there are no node directories, all of them stay on node 0).
+ */
+static void	read_node(t_topology *topo, int node)
+{
+	char	buf[4096];
+	int		fd;
+	int		cpu;
+	int		to;
+
+	snprintf(buf, sizeof(buf), "/sys/devices/system/node/node%d/cpulist",
+		node);
+	fd = open(buf, O_RDONLY);
+	if (fd < 0)
+		return ;
+	to = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (to < 0)
+		to = 0;
+	buf[to] = '\0';
+	fd = 0;
+	while (buf[fd] >= '0' && buf[fd] <= '9')
+	{
+		parse_range(buf, &fd, &cpu, &to);
+		while (cpu <= to && cpu < PLACE_MAX_CPUS)
+			topo->node_of[cpu++] = node;
+	}
+}
+
+/**
+ * Finds the cpus we may run on, their nodes and the distinct nodes among
+ * them. Done once per simulation, before anything is allocated or started.
+ */
+void	placement_init(t_shared *shared)
+{
+	t_topology	*topo;
+	cpu_set_t	set;
+	int			node;
+	int			i;
+
+	topo = &shared->topology;
+	memset(topo, 0, sizeof(t_topology));
+	node = -1;
+	while (++node < PLACE_MAX_NODES)
+		read_node(topo, node);
+	CPU_ZERO(&set);
+	sched_getaffinity(0, sizeof(set), &set);
+	i = -1;
+	while (++i < PLACE_MAX_CPUS)
+	{
+		if (!CPU_ISSET(i, &set))
+			continue ;
+		topo->cpus[topo->n_cpus++] = i;
+		node = 0;
+		while (node < topo->n_nodes && topo->nodes[node] != topo->node_of[i])
+			node++;
+		if (node == topo->n_nodes)
+			topo->nodes[topo->n_nodes++] = topo->node_of[i];
+	}
+}
+
+#else
+
+void	placement_init(t_shared *shared)
+{
+	memset(&shared->topology, 0, sizeof(t_topology));
+}
+
+#endif
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_pool_bonus.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:00:57 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:00:57 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+#ifdef __linux__
+
+/**
+ * Waits for a fork of the pool, at most until the deadline of the philo,
+ * taken on CLOCK_MONOTONIC (the clock of the simulation, see clock_setup):
+ * a wall clock jump moves neither.
+ * Return: 0 if there was none by then.
+ */
+static int	pool_wait(t_philo *p)
+{
+	struct timespec	ts;
+	long long		at;
+
+	at = p->clock.mono_origin + atomic_load(&p->deadline);
+	ts.tv_sec = at / 1000000;
+	ts.tv_nsec = (at % 1000000) * 1000;
+	while (sem_clockwait(&p->shm->fork_pool, CLOCK_MONOTONIC, &ts))
+		if (errno != EINTR)
+			return (0);
+	return (1);
+}
+
+#else
+
+/**
+ * Without sem_clockwait the pool is polled every POOL_POLL_US, up to the
+ * deadline of the philo.
+ */
+static int	pool_wait(t_philo *p)
+{
+	while (sem_trywait(&p->shm->fork_pool))
+	{
+		if (clock_now_us(&p->clock) >= atomic_load(&p->deadline))
+			return (0);
+		usleep(POOL_POLL_US);
+	}
+	return (1);
+}
+
+#endif
+
+/**
+ * One wait for a fork of the pool, with pool_lock not held: the watchdog
+ * can declare the philo dead meanwhile. in_pool tells it a fork may be
+ * taken but not counted yet, and it waits for the philo to be done with it
+ * (see philo_die): the fork is counted in holding_forks, or given back if
+ * the philo is dying by then, always under pool_lock.
+ * Return: 0 if no fork was taken.
+ */
+int	pool_acquire(t_philo *p)
+{
+	int	got;
+
+	pthread_mutex_lock(&p->pool_lock);
+	if (atomic_load(&p->dying))
+	{
+		pthread_mutex_unlock(&p->pool_lock);
+		return (0);
+	}
+	atomic_store(&p->in_pool, 1);
+	pthread_mutex_unlock(&p->pool_lock);
+	got = pool_wait(p);
+	pthread_mutex_lock(&p->pool_lock);
+	if (got && atomic_load(&p->dying))
+		sem_post(&p->shm->fork_pool);
+	else if (got)
+		atomic_fetch_add(&p->holding_forks, 1);
+	got = got && !atomic_load(&p->dying);
+	atomic_store(&p->in_pool, 0);
+	pthread_mutex_unlock(&p->pool_lock);
+	futex_wake(&p->in_pool, 1, 0);
+	return (got);
+}
+
+/**
+ * Gives back the forks of the philo, under pool_lock: each one is
+ * uncounted, then posted, as philo_die does.
+ */
+void	pool_put(t_philo *p)
+{
+	pthread_mutex_lock(&p->pool_lock);
+	while (atomic_load(&p->holding_forks) > 0)
+	{
+		atomic_fetch_sub(&p->holding_forks, 1);
+		sem_post(&p->shm->fork_pool);
+	}
+	pthread_mutex_unlock(&p->pool_lock);
+}
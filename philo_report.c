@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_report.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 14:18:06 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Names of the --strategy, --fork-lock, --engine and --placement chosen
+ * (which: 0 to 3), as given on the command line.
+ */
+const char	*opts_names(t_opts *opts, int which)
+{
+	static const char	*locks[] = {"pthread", "ticket", "mcs", "adaptive"};
+	static const char	*strategies[] = {"parity", "hierarchy", "waiter",
+		"waiter-half", "chandy-misra"};
+	static const char	*engines[] = {"threads", "fibers", "shards"};
+	static const char	*placements[] = {"none", "core", "node"};
+
+	if (which == 0)
+		return (strategies[opts->strategy]);
+	if (which == 1)
+		return (locks[opts->fork_lock]);
+	if (which == 2)
+		return (engines[opts->engine]);
+	return (placements[opts->placement]);
+}
+
+/**
+ * Counters of the forks summed together, printed with the names of the
+ * strategy and of the lock they were taken with (with Chandy-Misra the
+ * lock guards the fork's messages, not the fork itself), then the
+ * placement and how many times a fork went to a philo on another node.
+ */
+static void	report_forks(t_shared *shared)
+{
+	t_lock_stats	sum;
+	int				i;
+
+	memset(&sum, 0, sizeof(sum));
+	i = 0;
+	while (i < shared->n_philos)
+	{
+		sum.acquired += shared->forks[i].stats.acquired;
+		sum.contended += shared->forks[i].stats.contended;
+		sum.spins += shared->forks[i].stats.spins;
+		sum.parks += shared->forks[i].stats.parks;
+		sum.cross_node += shared->forks[i++].stats.cross_node;
+	}
+	fprintf(stderr, "forks: strategy=%s lock=%s acquired=%lld contended=%lld"
+		" spins=%lld parks=%lld\n", opts_names(&shared->opts, 0),
+		opts_names(&shared->opts, 1), sum.acquired, sum.contended,
+		sum.spins, sum.parks);
+	fprintf(stderr, "placement: mode=%s cpus=%d nodes=%d cross_node=%lld\n",
+		opts_names(&shared->opts, 3), shared->topology.n_cpus,
+		shared->topology.n_nodes, sum.cross_node);
+}
+
+/**
+ * With --fork-link=socket, one line per end of every link between two
+ * shards: the messages and requests / grants (ops) it sent, their rate
+ * over the run, and the round trip of its requests (request sent to grant
+ * received, microseconds).
+ */
+void	link_report(t_shared *shared, long long elapsed)
+{
+	t_link_stats	*st;
+	int				i;
+
+	i = -1;
+	while (++i < 2 * shared->engine.n_links)
+	{
+		st = &shared->engine.link_stats[i];
+		fprintf(stderr, "link: shards=%d->%d msgs=%lld ops=%lld "
+			"ops_per_sec=%.1f batch=%.2f requests=%lld rtt_p50_us=%lld "
+			"rtt_p99_us=%lld rtt_max_us=%lld\n", st->from, st->to,
+			st->msgs_out, st->ops_out, st->ops_out * 1e6 / elapsed,
+			(double)st->ops_out / (st->msgs_out + !st->msgs_out),
+			st->requests, hist_percentile(&st->rtt, 0.5),
+			hist_percentile(&st->rtt, 0.99), st->rtt.max);
+	}
+}
+
+/**
+ * The meals served (and their rate over the elapsed us of the run) and the
+ * longest any philo waited between two meals.
+ */
+static void	report_meals(t_shared *shared, long long elapsed)
+{
+	long long	meals;
+	long long	hunger;
+	int			i;
+
+	meals = 0;
+	hunger = 0;
+	i = -1;
+	while (++i < shared->n_philos)
+	{
+		meals += shared->philos[i].times_eaten;
+		if (shared->philos[i].max_hunger > hunger)
+			hunger = shared->philos[i].max_hunger;
+	}
+	fprintf(stderr, "meals: total=%lld per_sec=%.1f max_hunger_us=%lld\n",
+		meals, meals * 1e6 / elapsed, hunger);
+}
+
+/**
+ * Prints on stderr the counters collected during the simulation (--stats),
+ * summed over all the philos: the meals (see report_meals), the sleep
+ * overshoot and the fork counters, and how long the start took: creating
+ * every thread (up to t0, when they are released) and then getting the
+ * first philo to run. Then the links between shards, if any.
+ */
+void	report_stats(t_shared *shared)
+{
+	t_sleep_stats	sleep;
+	long long		elapsed;
+	int				i;
+
+	memset(&sleep, 0, sizeof(sleep));
+	i = -1;
+	while (++i < shared->n_philos)
+		sleep_stats_add(&sleep, &shared->philos[i].sleep_stats);
+	elapsed = shared->ended_at - shared->t0;
+	if (elapsed < 1)
+		elapsed = 1;
+	report_meals(shared, elapsed);
+	fprintf(stderr, "startup: spawn_us=%lld first_event_us=%lld\n",
+		shared->t0 - shared->spawn_start,
+		atomic_load(&shared->first_event) - shared->t0);
+	sleep_stats_print("philo", &sleep);
+	report_forks(shared);
+	link_report(shared, elapsed);
+}
@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_report_bonus.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:10:19 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:10:19 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * With --stats, once the simulation is over: the meals on the scoreboard,
+ * in total and over the run (from t0 to ended_at), how many philos got
+ * fed (of those who had a number of meals to eat), then the meals of each
+ * philo in id order.
+ */
+void	meals_report(t_philo *f_tmpl, long long ended_at)
+{
+	t_shm		*shm;
+	long long	total;
+	long long	elapsed;
+	int			i;
+
+	shm = f_tmpl->shm;
+	total = 0;
+	i = -1;
+	while (++i < shm->n)
+		total += atomic_load(&shm->seats[i].meals);
+	elapsed = ended_at - shm->t0;
+	if (elapsed < 1)
+		elapsed = 1;
+	fprintf(stderr, "meals: total=%lld per_sec=%.1f fed=%d/%d\n"
+		"meals_per_philo:", total, total * 1e6 / elapsed,
+		shm->targets - atomic_load(&shm->unfed), shm->targets);
+	i = -1;
+	while (++i < shm->n)
+		fprintf(stderr, " %d", atomic_load(&shm->seats[i].meals));
+	fprintf(stderr, "\n");
+}
+
+/**
+ * With --stats, once the simulation is over: the overshoot of the sleeps
+ * of every philo, from his seat. Most of them are killed rather than
+ * leaving by themselves (see cleanup), so they can not report their own.
+ */
+void	sleep_report(t_philo *f_tmpl)
+{
+	char	who[LOG_LINE_MAX];
+	int		i;
+
+	i = -1;
+	while (++i < f_tmpl->shm->n)
+	{
+		who[format_line(who, 0, i + 1, "philo") - 1] = '\0';
+		sleep_stats_print(who + 2, &f_tmpl->shm->seats[i].sleep_stats);
+	}
+}
@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_sem_bench.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 03:12:40 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * The line of a round: kind of semaphore, throughput (wall ns the round
+ * took) and the percentiles of the time a take waited, merged in hist.
+ */
+static void	round_report(int named, int procs, t_hist *hist, long long wall)
+{
+	static const char	*kinds[] = {"shared", "named"};
+
+	printf("%s: procs=%d takes=%lld takes_per_sec=%.0f p50_ns=%lld "
+		"p99_ns=%lld p99.9_ns=%lld max_ns=%lld\n", kinds[named], procs,
+		hist->count, hist->count * 1e9 / wall,
+		hist_percentile(hist, 0.5), hist_percentile(hist, 0.99),
+		hist_percentile(hist, 0.999), hist->max);
+	fflush(stdout);
+}
+
+/**
+ * One round: procs children hammering the same semaphore, one line with
+ * the throughput of the round (creating the semaphore and the children
+ * included) and the percentiles of the time a take waited, in ns.
+ * hists (shared with the children) has one histogram per child after the
+ * one they are merged into.
+ * Return: 0 if the semaphore could not be made or a child failed.
+ */
+static int	run(int named, int procs, int iterations, t_hist *hists)
+{
+	sem_t		*sem;
+	long long	wall;
+	int			i;
+	int			status;
+
+	memset(hists, 0, (procs + 1) * sizeof(t_hist));
+	wall = now_ns();
+	sem = sem_make(named);
+	i = -1;
+	while (sem != SEM_FAILED && ++i < procs)
+		if (fork() == 0)
+			hammer(sem, named, &hists[i + 1], iterations);
+	status = 0;
+	while (sem != SEM_FAILED && i-- > 0 && wait(&status) > 0 && !status)
+		;
+	wall = now_ns() - wall + 1;
+	if (sem == SEM_FAILED || status)
+		return (0);
+	sem_drop(sem, named);
+	while (++i < procs)
+		hist_merge(&hists[0], &hists[i + 1]);
+	round_report(named, procs, &hists[0], wall);
+	return (1);
+}
+
+/**
+ * --procs=<n> and --iterations=<n>, in any order, over the defaults.
+ * Return: 0 on anything else or a count that is not positive.
+ */
+static int	parse_args(int argc, char **argv, int *procs, int *iterations)
+{
+	int	i;
+
+	*procs = SEM_BENCH_PROCS;
+	*iterations = SEM_BENCH_ITERATIONS;
+	i = 0;
+	while (++i < argc && (opt_value(argv[i], "procs")
+			|| opt_value(argv[i], "iterations")))
+	{
+		if (opt_value(argv[i], "procs"))
+			*procs = parse_num(opt_value(argv[i], "procs"));
+		else
+			*iterations = parse_num(opt_value(argv[i], "iterations"));
+	}
+	return (i >= argc && *procs > 0 && *iterations > 0);
+}
+
+/**
+ * Contended acquire latency of the semaphores philo_bonus could use:
+ *  philo_sem_bench [--procs=<n>] [--iterations=<n>]
+ * named ones (what the bonus used to open in every child) against process
+ * shared ones in an anonymous mapping (what it uses now, see s_shm).
+ */
+int	main(int argc, char **argv)
+{
+	t_hist	*hists;
+	int		procs;
+	int		iterations;
+
+	hists = MAP_FAILED;
+	if (parse_args(argc, argv, &procs, &iterations))
+		hists = mmap(NULL, (procs + 1) * sizeof(t_hist),
+				PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (hists == MAP_FAILED)
+	{
+		printf("Usage: philo_sem_bench [--procs=<n>] [--iterations=<n>]\n");
+		return (1);
+	}
+	if (!run(1, procs, iterations, hists) || !run(0, procs, iterations, hists))
+		return (1);
+	munmap(hists, (procs + 1) * sizeof(t_hist));
+	return (0);
+}
@@ -0,0 +1,82 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_sem_bench_utils.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:30:13 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:30:13 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+long long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000LL + ts.tv_nsec);
+}
+
+/**
+ * A child: takes sem, holds it for SEM_BENCH_HOLD spins (a fork being
+ * used), gives it back, iterations times, recording in hist how long every
+ * take waited (ns). A named semaphore is first opened by name, as the
+ * children of philo_bonus used to.
+ */
+void	hammer(sem_t *sem, int named, t_hist *hist, int iterations)
+{
+	long long	t;
+	int			i;
+
+	if (named)
+		sem = sem_open(SEM_BENCH_NAME, 0);
+	if (sem == SEM_FAILED)
+		exit(1);
+	while (iterations--)
+	{
+		t = now_ns();
+		sem_wait(sem);
+		hist_record(hist, now_ns() - t);
+		i = 0;
+		while (i++ < SEM_BENCH_HOLD)
+			cpu_relax();
+		sem_post(sem);
+	}
+	exit(0);
+}
+
+/**
+ * A binary semaphore, named (sem_open, backed by a file under /dev/shm) or
+ * unnamed in an anonymous shared mapping (sem_init, process shared), and
+ * the way to get rid of it.
+ */
+sem_t	*sem_make(int named)
+{
+	sem_t	*sem;
+
+	if (named)
+	{
+		sem_unlink(SEM_BENCH_NAME);
+		return (sem_open(SEM_BENCH_NAME, O_CREAT, 0600, 1));
+	}
+	sem = mmap(NULL, sizeof(sem_t), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (sem == MAP_FAILED || sem_init(sem, 1, 1))
+		return (SEM_FAILED);
+	return (sem);
+}
+
+void	sem_drop(sem_t *sem, int named)
+{
+	if (named)
+	{
+		sem_close(sem);
+		sem_unlink(SEM_BENCH_NAME);
+		return ;
+	}
+	sem_destroy(sem);
+	munmap(sem, sizeof(sem_t));
+}
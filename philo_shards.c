@@ -0,0 +1,118 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_shards.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 02:38:49 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef __linux__
+
+/**
+ * A shard outliving the parent would go on eating with nobody to stop it.
+ */
+static void	die_with_parent(void)
+{
+	prctl(PR_SET_PDEATHSIG, SIGKILL);
+}
+
+#else
+
+static void	die_with_parent(void)
+{
+}
+
+#endif
+
+/**
+ * The life of shard process s: starts its end of the links (if any) and
+ * the threads of its philos, counts itself ready, and leaves once they all
+ * left (the parent reaps it).
+ * If a thread can not be created the simulation is stopped, and the shard
+ * leaves at once, taking the threads it started (still at the start gate)
+ * with it.
+ */
+static void	shard_main(t_shared *shared, int s)
+{
+	pthread_t	link;
+	int			from;
+	int			to;
+	int			ok;
+
+	die_with_parent();
+	from = (long long)s * shared->n_philos / shared->engine.n_shards;
+	to = (long long)(s + 1) * shared->n_philos / shared->engine.n_shards;
+	ok = (!shared->engine.n_links || link_attach(shared, s, &link))
+		&& start_threads(shared, from, to);
+	if (!ok)
+		stop_simulation(shared, NULL, 0, 0);
+	atomic_fetch_add(&shared->engine.shards_ready, 1);
+	futex_wake(&shared->engine.shards_ready, 1, 1);
+	while (ok && from < to)
+		pthread_join(shared->engine.threads[from++], NULL);
+	if (ok && shared->engine.n_links)
+		pthread_join(link, NULL);
+	_exit(!ok);
+}
+
+/**
+ * Forks the shard processes (with the links between them first, see
+ * link_setup: we keep none of their ends), then waits until every one of
+ * them started all its threads (see shards_wait).
+ * Return: 0 if a shard could not be forked or did not start.
+ */
+int	shards_start(t_shared *shared)
+{
+	t_engine	*e;
+	int			s;
+
+	e = &shared->engine;
+	e->shards = malloc(e->n_shards * sizeof(pid_t));
+	if (!e->shards || (shared->opts.fork_link == LINK_SOCKET
+			&& e->n_shards > 1 && !link_setup(shared)))
+		return (0);
+	s = -1;
+	while (++s < e->n_shards)
+	{
+		e->shards[s] = fork();
+		if (e->shards[s] < 0)
+			return (0);
+		if (e->shards[s] == 0)
+			shard_main(shared, s);
+	}
+	if (e->n_links)
+		link_attach(shared, -1, NULL);
+	return (shards_wait(shared));
+}
+
+/**
+ * Reaps the shard processes once the simulation stopped. A shard that
+ * crashed only took its own philos with it: the death monitor, in the
+ * parent, reported the first of them that starved; here we say why.
+ */
+void	shards_stop(t_shared *shared)
+{
+	int	status;
+	int	s;
+
+	s = -1;
+	while (++s < shared->engine.n_shards)
+	{
+		if (waitpid(shared->engine.shards[s], &status, 0) > 0
+			&& WIFSIGNALED(status))
+			fprintf(stderr, "shard %d: killed by signal %d\n", s,
+				WTERMSIG(status));
+	}
+	free(shared->engine.shards);
+	free(shared->engine.links);
+	free(shared->engine.lforks);
+	shared->engine.shards = NULL;
+	shared->engine.links = NULL;
+	shared->engine.lforks = NULL;
+}
@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_shards_utils.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:19:40 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:19:40 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Zeroed memory for the table: shared with the shard processes when there
+ * are any, private otherwise.
+ * Return: NULL if the mapping failed.
+ */
+void	*table_map(t_shared *shared, size_t len)
+{
+	void	*mem;
+	int		flags;
+
+	flags = MAP_PRIVATE | MAP_ANONYMOUS;
+	if (shared->engine.n_shards)
+		flags = MAP_SHARED | MAP_ANONYMOUS;
+	mem = mmap(NULL, len, PROT_READ | PROT_WRITE, flags, -1, 0);
+	if (mem == MAP_FAILED)
+		return (NULL);
+	return (mem);
+}
+
+/**
+ * Shard s runs the philos from s * n / n_shards up to (excluded) the first
+ * one of shard s + 1, so philo (index) j is in shard
+ * ((j + 1) * n_shards - 1) / n.
+ */
+int	shard_of(t_shared *shared, int philo)
+{
+	return ((((long long)philo + 1) * shared->engine.n_shards - 1)
+		/ shared->n_philos);
+}
+
+/**
+ * Fork i is used by philo i and by the one before him: it lives between
+ * two shards when they are not in the same one.
+ */
+int	shard_boundary(t_shared *shared, int fork)
+{
+	if (shared->engine.n_shards < 2)
+		return (0);
+	return (shard_of(shared, fork) != shard_of(shared,
+			(fork + shared->n_philos - 1) % shared->n_philos));
+}
+
+/**
+ * Waits until every shard started all its threads (see shard_main). A
+ * shard gone before that is a failed start: the shards left leave with us.
+ * Return: 0 if a shard did not start.
+ */
+int	shards_wait(t_shared *shared)
+{
+	t_engine	*e;
+	int			ready;
+
+	e = &shared->engine;
+	ready = atomic_load(&e->shards_ready);
+	while (ready < e->n_shards)
+	{
+		if (waitpid(-1, NULL, WNOHANG) > 0)
+			return (0);
+		futex_wait(&e->shards_ready, ready, 1, STRATEGY_POLL_US);
+		ready = atomic_load(&e->shards_ready);
+	}
+	return (1);
+}
@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_sim.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 20:58:14 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * The t_shared of a simulation, zeroed, in memory that the shard processes
+ * see as well (see shards_start): the flags, the end event and the start
+ * gate of the simulation work the same from any of them.
+ * Return: NULL if the mapping failed.
+ */
+t_shared	*shared_new(void)
+{
+	t_shared	*shared;
+
+	shared = mmap(NULL, sizeof(t_shared), PROT_READ | PROT_WRITE,
+			MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+	if (shared == MAP_FAILED)
+		return (NULL);
+	return (shared);
+}
+
+void	shared_free(t_shared *shared)
+{
+	if (shared)
+		munmap(shared, sizeof(t_shared));
+}
+
+/**
+ * Everything a simulation needs, for a table of n philos with the timings
+ * of shared->config (or shared->workload) and shared->opts (the rest of
+ * shared zeroed), its log going to fd (-1 to discard it).
+ * Return: 1 on success, 0 otherwise.
+ */
+int	sim_setup(t_shared *shared, int n, int fd)
+{
+	if (!init_state(shared))
+		return (0);
+	engine_configure(shared, n);
+	placement_init(shared);
+	if (!init_arena(shared, n) || !init_log(shared, n, fd)
+		|| !init_philos(shared))
+		return (0);
+	return (1);
+}
+
+/**
+ * Starts the philos (see engine_start), then the log writer, then lets the
+ * philos go and starts the death monitor (see engine_go): the shard
+ * processes are forked while we have no other thread.
+ * The simulation_active atomic flag is the way all the threads know about the
+ * current state of the simulation. When one of the philos terminates (or the
+ * death monitor finds one dead) stop_simulation clears it and signals the end
+ * event.
+ * Here we block on the end event (no polling, no cpu used meanwhile), or
+ * for --run-for milliseconds at most, then we stop the engine (every philo
+ * is gone once it returns) and only then the log writer, so that every
+ * queued line is on screen before we return.
+ * With --virtual-time the limit is in simulated time, the worker enforces
+ * it (see virtual_advance). ended_at is when the stop was seen, on the
+ * simulation clock.
+ *
+ * @param shared_resources contains the philos, the simulation_active flag
+ * and the end event
+ * @return 0 on failure (e.g., thread creation issues), 1 otherwise.
+ */
+int	sim_run(t_shared *shared_resources)
+{
+	pthread_t	writer;
+	long long	limit;
+
+	clock_setup(&shared_resources->clock, shared_resources->opts.clock_source);
+	if (shared_resources->stats_file)
+		shared_resources->stats_file->mono_origin
+			= shared_resources->clock.mono_origin;
+	if (!engine_start(shared_resources)
+		|| pthread_create(&writer, NULL, log_writer, shared_resources)
+		|| !engine_go(shared_resources))
+		return (0);
+	limit = shared_resources->opts.run_for_ms * 1000;
+	if (!limit || shared_resources->opts.virtual_time)
+		limit = -1;
+	if (!wait_end(shared_resources, limit))
+		stop_simulation(shared_resources, NULL, 0, 0);
+	shared_resources->ended_at = clock_now_us(&shared_resources->clock);
+	engine_stop(shared_resources);
+	atomic_store_explicit(&shared_resources->writer_stop, 1,
+		memory_order_release);
+	pthread_join(writer, NULL);
+	return (1);
+}
+
+/**
+ * Releases what sim_setup allocated, once sim_run returned.
+ */
+void	sim_teardown(t_shared *shared)
+{
+	int	i;
+
+	i = 0;
+	while (i < shared->n_philos)
+		fork_destroy(&shared->forks[i++]);
+	pthread_mutex_destroy(&shared->end_mutex);
+	pthread_cond_destroy(&shared->end_cond);
+	free(shared->sink.buf);
+	free(shared->log_heap.nodes);
+	free(shared->monitor_heap.nodes);
+	if (shared->hists)
+		munmap(shared->hists, shared->n_hists * HIST_KINDS * sizeof(t_hist));
+	if (shared->engine.link_stats)
+		munmap(shared->engine.link_stats,
+			2 * shared->engine.n_shards * sizeof(t_link_stats));
+	if (shared->arena)
+		munmap(shared->arena, shared->arena_len);
+	if (shared->stats_file)
+		atomic_store(&shared->stats_file->died, shared->died);
+	stats_close(shared->stats_file);
+}
@@ -0,0 +1,117 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_sim_init.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:22:50 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:22:50 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Sets up the output batch, written on fd, and allocates the heaps the log
+ * writer and the death monitor work on (the rings are in the arena).
+ * Everything is allocated here, once, so that neither logging nor the
+ * monitor ever allocate while the simulation runs.
+ */
+int	init_log(t_shared *shared, int number_of_philosophers, int fd)
+{
+	if (!sink_init(&shared->sink, fd, shared->opts.log_batch,
+			shared->opts.log_flush_ms))
+		return (0);
+	shared->log_heap.nodes = malloc(shared->n_rings * sizeof(t_heap_node));
+	shared->monitor_heap.nodes = malloc(number_of_philosophers
+			* sizeof(t_heap_node));
+	if (!shared->log_heap.nodes || !shared->monitor_heap.nodes)
+		return (0);
+	return (1);
+}
+
+/**
+ * The philos, the forks, the event rings (one per philo, or per worker with
+ * the fibers engine, plus one for the death monitor) and the handles of the
+ * philo threads, in a single mapping made once (see table_map), the philos
+ * first: every t_philo and t_fork being a whole number of cache lines, each
+ * of them starts on its own. The pages come zeroed.
+ * With --placement=node the philos and the forks go on the node of the
+ * threads using them.
+ */
+int	init_arena(t_shared *shared, int n)
+{
+	size_t	philos_len;
+	size_t	forks_len;
+	size_t	rings_len;
+
+	shared->n_rings = n + 1;
+	if (shared->engine.n_workers)
+		shared->n_rings = shared->engine.n_workers + 1;
+	philos_len = n * sizeof(t_philo);
+	forks_len = n * sizeof(t_fork);
+	rings_len = shared->n_rings * sizeof(t_ring);
+	shared->arena_len = philos_len + forks_len + rings_len
+		+ n * sizeof(pthread_t);
+	shared->arena = table_map(shared, shared->arena_len);
+	if (!shared->arena)
+		return (0);
+	shared->philos = (t_philo *)shared->arena;
+	shared->forks = (t_fork *)(shared->arena + philos_len);
+	shared->rings = (t_ring *)(shared->arena + philos_len + forks_len);
+	shared->engine.threads = (pthread_t *)(shared->arena + philos_len
+			+ forks_len + rings_len);
+	placement_bind(shared, shared->philos, sizeof(t_philo), n);
+	placement_bind(shared, shared->forks, sizeof(t_fork), n);
+	shared->n_philos = n;
+	return (1);
+}
+
+/**
+ * Philo i (from 0) and his fork, the left one: his right one is the left
+ * one of the next philo.
+ */
+static void	init_philo(t_shared *shared, int i)
+{
+	t_philo	*p;
+
+	p = &shared->philos[i];
+	fork_init(&shared->forks[i], shared->opts.fork_lock,
+		shard_boundary(shared, i));
+	p->id = i + 1;
+	p->config = &shared->config;
+	if (shared->workload.timings)
+		p->config = shared->workload.timings + i;
+	p->rng = rng_seed(shared->workload.seed, i + 1);
+	p->left_fork = &shared->forks[i];
+	p->right_fork = &shared->forks[(i + 1) % shared->n_philos];
+	p->ring = &shared->rings[i];
+	p->shared_resources = shared;
+}
+
+/**
+ * Initialize each philo and assign them the relative couple of
+ * forks (guarded by the lock chosen with --fork-lock, taken as the
+ * --strategy says, shared between processes when between two shards), its
+ * own event ring and a reference to the shared resources and to his timings
+ * (the config they all read, or his own with a --workload), his jitter
+ * drawn from his own generator.
+ * Their last meal (and deadline) is only set when they are released, see
+ * engine_go.
+*/
+int	init_philos(t_shared *shared_resources)
+{
+	int	i;
+
+	i = 0;
+	while (i < shared_resources->n_philos)
+		init_philo(shared_resources, i++);
+	strategy_init(shared_resources);
+	if (!grants_init(shared_resources))
+		return (0);
+	if (shared_resources->engine.n_workers && !fibers_init(shared_resources))
+		return (0);
+	return (histograms_init(shared_resources)
+		&& stats_file_init(shared_resources));
+}
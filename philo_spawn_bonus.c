@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_spawn_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 05:21:09 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+size_t	shm_size(int n_philos)
+{
+	return (sizeof(t_shm) + n_philos * sizeof(t_seat));
+}
+
+#ifdef __linux__
+
+/**
+ * With --spawn=tree most philos are not our children: once their parent
+ * philo is killed they are reparented to us, not to init, and cleanup
+ * reaps them as well.
+ */
+static void	adopt_orphans(void)
+{
+	prctl(PR_SET_CHILD_SUBREAPER, 1);
+}
+
+#else
+
+static void	adopt_orphans(void)
+{
+}
+
+#endif
+
+/**
+ * Waits for the n_philos children to be ready. A child who could not fork
+ * his own says so (failed) and wakes us up; one who died before being
+ * ready is found by waitpid, checked every SPAWN_POLL_US: either way we do
+ * not wait for the rest.
+ * Return: 0 if the spawn failed.
+ */
+static int	wait_ready(t_shm *shm, int n_philos)
+{
+	int	ready;
+
+	ready = atomic_load(&shm->ready);
+	while (ready < n_philos && !atomic_load(&shm->failed))
+	{
+		if (waitpid(-1, NULL, WNOHANG) > 0)
+			atomic_store(&shm->failed, 1);
+		futex_wait(&shm->ready, ready, 1, SPAWN_POLL_US);
+		ready = atomic_load(&shm->ready);
+	}
+	return (!atomic_load(&shm->failed));
+}
+
+/**
+ * Creates the processes of the philos.
+ * Relevant Elements/Functions:
+ * Fork(): creates (spawns) a new process
+ * When you call fork(), it creates a new process that is an almost exact copy
+ * of the current process. Both the parent and the child continue executing
+ * from the point where fork() was called. The only difference is the value
+ * returned by fork():
+ * In the parent process, fork() returns the child's Process ID (PID),
+ * which is a positive integer. In the child process, fork() returns 0.
+ * So when you check if (pid == 0), you're essentially asking,
+ * "Am I the child process?" If the answer is yes, you proceed to run
+ * child_main, which never returns.
+ * Conversely, if (pid < 0) the fork() failed to create a new process: we
+ * stop there (cleanup kills any process created up to that point).
+ * With --spawn=tree we only fork the first philo, who forks the others.
+ *
+ * Then we wait for all of them to be ready (see wait_ready), and release
+ * them together: they all had their last meal at t0.
+ * Return: 0 if a fork failed.
+ */
+int	spawn_philos(t_philo *f_tmpl, int n_philos)
+{
+	t_shm	*shm;
+	pid_t	pid;
+	int		i;
+
+	shm = f_tmpl->shm;
+	adopt_orphans();
+	i = 0;
+	while (++i <= n_philos && !atomic_load(&shm->failed))
+	{
+		pid = fork();
+		if (pid == 0)
+			child_main(f_tmpl, i);
+		if (pid < 0)
+			atomic_store(&shm->failed, 1);
+		if (f_tmpl->opts.spawn == SPAWN_TREE)
+			break ;
+	}
+	if (!wait_ready(shm, n_philos))
+		return (0);
+	shm->t0 = clock_now_us(&f_tmpl->clock);
+	atomic_store(&shm->go, 1);
+	futex_wake(&shm->go, INT_MAX, 1);
+	return (1);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_state.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 16:03:11 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * simulation_active is an atomic read by every philo at every transition
+ * without taking any lock. The end of the simulation is also published as
+ * an event (ended, under end_mutex / end_cond) for the threads that have
+ * nothing better to do than waiting for it.
+ * end_cond runs on CLOCK_MONOTONIC, the clock sleep_until works on. With
+ * the shards engine the philos that end the simulation are in another
+ * process: the end event is process shared.
+ */
+int	init_state(t_shared *shared)
+{
+	pthread_condattr_t	attr;
+	pthread_mutexattr_t	mattr;
+	int					pshared;
+
+	atomic_init(&shared->simulation_active, 1);
+	atomic_init(&shared->stop_claimed, 0);
+	atomic_init(&shared->writer_stop, 0);
+	atomic_init(&shared->started, 0);
+	atomic_init(&shared->first_event, -1);
+	shared->died = 0;
+	shared->ended = 0;
+	pshared = PTHREAD_PROCESS_PRIVATE;
+	if (shared->opts.engine == ENGINE_SHARDS)
+		pshared = PTHREAD_PROCESS_SHARED;
+	if (pthread_condattr_init(&attr) || pthread_mutexattr_init(&mattr)
+		|| pthread_condattr_setclock(&attr, CLOCK_MONOTONIC)
+		|| pthread_condattr_setpshared(&attr, pshared)
+		|| pthread_mutexattr_setpshared(&mattr, pshared)
+		|| pthread_cond_init(&shared->end_cond, &attr)
+		|| pthread_mutex_init(&shared->end_mutex, &mattr))
+		return (0);
+	pthread_condattr_destroy(&attr);
+	pthread_mutexattr_destroy(&mattr);
+	return (1);
+}
+
+int	simulation_running(t_shared *shared)
+{
+	return (atomic_load_explicit(&shared->simulation_active,
+			memory_order_acquire));
+}
+
+/**
+ * Ends the simulation, either because philo `id` died at `now` (then ring,
+ * which must be owned by the calling thread, receives the "died" event and
+ * id is kept in died) or because the meals are over (ring is NULL).
+ * Only the first caller goes through: the event is queued before clearing
+ * the flag (release), so the log writer, once it sees the simulation stopped,
+ * is sure to find it; then the philos asleep (see engine_sleep_until) and
+ * the waiters of the end event are woken up, once.
+ */
+void	stop_simulation(t_shared *shared, t_ring *ring, long long now, int id)
+{
+	if (atomic_exchange_explicit(&shared->stop_claimed, 1,
+			memory_order_acq_rel))
+		return ;
+	if (ring)
+	{
+		ring_push(ring, now / 1000, id, ACT_DIED);
+		shared->died = id;
+	}
+	atomic_store_explicit(&shared->simulation_active, 0, memory_order_release);
+	futex_wake(&shared->simulation_active, INT_MAX,
+		shared->engine.n_shards != 0);
+	pthread_mutex_lock(&shared->end_mutex);
+	shared->ended = 1;
+	pthread_cond_broadcast(&shared->end_cond);
+	pthread_mutex_unlock(&shared->end_mutex);
+}
+
+/**
+ * Blocks (without using any cpu) until the simulation ends, or until the
+ * clock reads `deadline` if that is not negative.
+ * Return: 1 if the simulation ended, 0 on timeout.
+ */
+int	wait_end(t_shared *shared, long long deadline)
+{
+	struct timespec	ts;
+	int				ended;
+
+	deadline += shared->clock.mono_origin;
+	ts.tv_sec = deadline / 1000000;
+	ts.tv_nsec = (deadline % 1000000) * 1000;
+	pthread_mutex_lock(&shared->end_mutex);
+	while (!shared->ended)
+	{
+		if (deadline < shared->clock.mono_origin)
+			pthread_cond_wait(&shared->end_cond, &shared->end_mutex);
+		else if (pthread_cond_timedwait(&shared->end_cond,
+				&shared->end_mutex, &ts) == ETIMEDOUT)
+			break ;
+	}
+	ended = shared->ended;
+	pthread_mutex_unlock(&shared->end_mutex);
+	return (ended);
+}
@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_stats.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:02:51 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * Maps, read only, the stats file written by a philo or philo_bonus run
+ * (running or over). The file has to be as long as its header says: past
+ * its end the mapping would fault on the first read.
+ * Return: the mapping, NULL if the file is missing or not a stats file.
+ */
+static t_stats_head	*stats_open(const char *path)
+{
+	t_stats_head	head;
+	t_stats_head	*map;
+	struct stat		st;
+	int				fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	map = MAP_FAILED;
+	if (read_all(fd, &head, sizeof(head)) && head.magic == STATS_MAGIC
+		&& head.version == STATS_VERSION && head.n > 0 && !fstat(fd, &st)
+		&& (size_t)st.st_size >= stats_size(head.n))
+		map = mmap(NULL, stats_size(head.n), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (map == MAP_FAILED)
+		return (NULL);
+	return (map);
+}
+
+/**
+ * Whether the simulation is still going: running is only dropped by a run
+ * that ends normally, one killed (SIGKILL, a crash) leaves it set, so the
+ * process that created the file has to be there as well (EPERM: it is,
+ * owned by someone else).
+ */
+static int	writer_alive(t_stats_head *head)
+{
+	if (!atomic_load(&head->running))
+		return (0);
+	return (kill(head->pid, 0) == 0 || errno == EPERM);
+}
+
+/**
+ * Options of philo_stats: --prometheus, --watch=<ms>, then the file.
+ * Return: 0 on invalid arguments.
+ */
+static int	parse_args(int argc, char **argv, int *prom, int *watch)
+{
+	int	i;
+
+	*prom = 0;
+	*watch = 0;
+	i = 0;
+	while (++i < argc - 1)
+	{
+		if (opt_flag(argv[i], "prometheus"))
+			*prom = 1;
+		else if (opt_value(argv[i], "watch"))
+			*watch = parse_num(opt_value(argv[i], "watch"));
+		else
+			return (0);
+	}
+	return (argc >= 2 && *watch >= 0);
+}
+
+/**
+ * Prints the counters once, or every watch ms for as long as the
+ * simulation goes on.
+ */
+static void	watch_file(t_stats_head *head, t_stats_view *views, int prom,
+		int watch)
+{
+	print_snapshot(head, views, prom);
+	while (watch && writer_alive(head))
+	{
+		usleep(watch * 1000);
+		print_snapshot(head, views, prom);
+	}
+}
+
+/**
+ * Reader of --stats-file, safe to run against a live simulation:
+ *  philo_stats [--prometheus] [--watch=<ms>] <file>
+ * prints the counters once, or every ms until the simulation is over (or
+ * gone, see writer_alive).
+ */
+int	main(int argc, char **argv)
+{
+	t_stats_head	*head;
+	t_stats_view	*views;
+	int				prom;
+	int				watch;
+
+	if (!parse_args(argc, argv, &prom, &watch))
+	{
+		printf("Usage: philo_stats [--prometheus] [--watch=<ms>] <file>\n");
+		return (1);
+	}
+	head = stats_open(argv[argc - 1]);
+	views = NULL;
+	if (head)
+		views = malloc(head->n * sizeof(t_stats_view));
+	if (!views)
+	{
+		printf("Invalid stats file: %s\n", argv[argc - 1]);
+		return (1);
+	}
+	watch_file(head, views, prom, watch);
+	free(views);
+	munmap(head, stats_size(head->n));
+	return (0);
+}
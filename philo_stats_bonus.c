@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_stats_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:46:09 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:11:27 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * Maps the --stats-file before the children are forked: they all inherit
+ * the shared mapping, each one then writes in his own slot only.
+ * Return: 0 if the file could not be created.
+ */
+int	stats_file_init(t_philo *f_tmpl, int n_philos)
+{
+	if (!f_tmpl->opts.stats_path)
+		return (1);
+	f_tmpl->stats_file = stats_create(f_tmpl->opts.stats_path, n_philos);
+	if (!f_tmpl->stats_file)
+	{
+		printf("Could not create the stats file: %s\n",
+			f_tmpl->opts.stats_path);
+		return (0);
+	}
+	f_tmpl->stats_file->mono_origin = f_tmpl->clock.mono_origin;
+	return (1);
+}
+
+/**
+ * Same counters, same slot layout as philo (see the mandatory
+ * stats_publish); a dying philo also leaves his id in the header.
+ */
+void	stats_publish(t_philo *p, int activity)
+{
+	t_stats_view	view;
+
+	if (activity == ACT_DIED)
+		atomic_store(&p->stats_file->died, p->id);
+	view.state = activity;
+	view.times_eaten = p->times_eaten;
+	view.fork_wait_us = p->fork_wait;
+	view.last_meal_us = p->last_meal_time;
+	if (activity == ACT_EAT)
+		view.last_meal_us = p->now;
+	stats_write(&p->stats_file->slots[p->id - 1], &view);
+}
+
+#ifdef __linux__
+
+/**
+ * Resident set of process pid, in KB (0 if it is gone): the second field
+ * of /proc/<pid>/statm, in pages. Pages shared with the others (the code,
+ * the shared mappings) are counted in every process.
+ */
+static long long	rss_kb(pid_t pid)
+{
+	char		buf[128];
+	char		*s;
+	int			fd;
+	ssize_t		len;
+	long long	pages;
+
+	snprintf(buf, sizeof(buf), "/proc/%d/statm", (int)pid);
+	fd = open(buf, O_RDONLY);
+	if (fd < 0)
+		return (0);
+	len = read(fd, buf, sizeof(buf) - 1);
+	close(fd);
+	if (len <= 0)
+		return (0);
+	buf[len] = '\0';
+	s = buf;
+	while (*s && *s != ' ')
+		s++;
+	pages = ft_atoi(s);
+	return (pages * sysconf(_SC_PAGESIZE) / 1024);
+}
+
+#else
+
+static long long	rss_kb(pid_t pid)
+{
+	(void)pid;
+	return (0);
+}
+
+#endif
+
+/**
+ * With --stats, once the simulation is over and before the philos are
+ * killed: how long creating all of them took, from the first fork to the
+ * moment every one was ready, and their resident memory, on average over
+ * the ones still there and at most.
+ */
+void	spawn_report(t_philo *f_tmpl, long long spawn_us)
+{
+	static const char	*modes[] = {"fork", "tree"};
+	long long			rss;
+	long long			sum;
+	long long			max;
+	int					i;
+	int					alive;
+
+	sum = 0;
+	max = 0;
+	alive = 0;
+	i = -1;
+	while (++i < f_tmpl->shm->n)
+	{
+		rss = rss_kb(f_tmpl->shm->seats[i].pid);
+		sum += rss;
+		alive += rss > 0;
+		if (rss > max)
+			max = rss;
+	}
+	if (alive < 1)
+		alive = 1;
+	fprintf(stderr, "spawn: mode=%s philos=%d total_us=%lld per_philo_us=%.1f"
+		" rss_avg_kb=%lld rss_max_kb=%lld\n", modes[f_tmpl->opts.spawn],
+		f_tmpl->shm->n, spawn_us, (double)spawn_us / f_tmpl->shm->n,
+		sum / alive, max);
+}
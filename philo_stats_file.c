@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_stats_file.c                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:31:48 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 22:31:48 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Maps the --stats-file and gives every philo his slot.
+ * Return: 0 if the file could not be created.
+ */
+int	stats_file_init(t_shared *shared)
+{
+	int	i;
+
+	if (!shared->opts.stats_path)
+		return (1);
+	shared->stats_file = stats_create(shared->opts.stats_path,
+			shared->n_philos);
+	if (!shared->stats_file)
+	{
+		printf("Could not create the stats file: %s\n",
+			shared->opts.stats_path);
+		return (0);
+	}
+	i = -1;
+	while (++i < shared->n_philos)
+		shared->philos[i].stats_slot = &shared->stats_file->slots[i];
+	return (1);
+}
+
+/**
+ * Publishes the counters of the philo as he starts activity. "is eating"
+ * is logged just before the meal is accounted for (see start_meal), so
+ * the meal it starts is taken as the last one already.
+ */
+void	stats_publish(t_philo *p, int activity)
+{
+	t_stats_view	view;
+
+	view.state = activity;
+	view.times_eaten = p->times_eaten;
+	view.fork_wait_us = p->fork_wait;
+	view.last_meal_us = p->last_meal_time;
+	if (activity == ACT_EAT)
+		view.last_meal_us = p->now;
+	stats_write(p->stats_slot, &view);
+}
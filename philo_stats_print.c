@@ -0,0 +1,109 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_stats_print.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 23:20:12 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * The state of a philo as printed, "stale" when his slot could not be read
+ * consistently (see stats_read).
+ */
+static const char	*state_name(const t_stats_view *view)
+{
+	if (view->stale)
+		return ("stale");
+	return (activity_name(view->state));
+}
+
+void	print_table(t_stats_head *head, t_stats_view *views, long long now)
+{
+	int	i;
+
+	printf("pid=%d running=%d died=%d elapsed_ms=%.1f\n", head->pid,
+		atomic_load(&head->running), atomic_load(&head->died), now / 1e3);
+	printf("%6s  %-16s %10s %14s %14s %10s\n", "id", "state", "meals",
+		"fork_wait_ms", "last_meal_ms", "hunger_ms");
+	i = -1;
+	while (++i < head->n)
+		printf("%6d  %-16s %10lld %14.1f %14.1f %10.1f\n", i + 1,
+			state_name(&views[i]), views[i].times_eaten,
+			views[i].fork_wait_us / 1e3, views[i].last_meal_us / 1e3,
+			(now - views[i].last_meal_us) / 1e3);
+}
+
+/**
+ * One metric, for every philo, in the Prometheus text format. which picks
+ * the counter: meals, fork wait, last meal (both in seconds) or the state,
+ * as a 1 labelled with its name.
+ */
+static void	prom_metric(t_stats_head *head, t_stats_view *views,
+		const char *name, int which)
+{
+	static const char	*states[] = {"fork", "eating", "sleeping",
+		"thinking", "died"};
+	static const char	*types[] = {"counter", "counter", "gauge", "gauge"};
+	int					i;
+
+	printf("# TYPE philo_%s %s\n", name, types[which]);
+	i = -1;
+	while (++i < head->n)
+	{
+		if (which == 0)
+			printf("philo_%s{philo=\"%d\"} %lld\n", name, i + 1,
+				views[i].times_eaten);
+		else if (which == 1)
+			printf("philo_%s{philo=\"%d\"} %.6f\n", name, i + 1,
+				views[i].fork_wait_us / 1e6);
+		else if (which == 2)
+			printf("philo_%s{philo=\"%d\"} %.6f\n", name, i + 1,
+				views[i].last_meal_us / 1e6);
+		else if (views[i].stale)
+			printf("philo_%s{philo=\"%d\",state=\"stale\"} 1\n", name,
+				i + 1);
+		else
+			printf("philo_%s{philo=\"%d\",state=\"%s\"} 1\n", name, i + 1,
+				states[views[i].state]);
+	}
+}
+
+void	print_prom(t_stats_head *head, t_stats_view *views)
+{
+	printf("# TYPE philo_running gauge\nphilo_running %d\n",
+		atomic_load(&head->running));
+	printf("# TYPE philo_died gauge\nphilo_died %d\n",
+		atomic_load(&head->died));
+	prom_metric(head, views, "meals_total", 0);
+	prom_metric(head, views, "fork_wait_seconds_total", 1);
+	prom_metric(head, views, "last_meal_seconds", 2);
+	prom_metric(head, views, "state", 3);
+}
+
+/**
+ * Reads every slot (through its seqlock, nothing is ever locked, the
+ * simulation never waits for us) and prints them, as a table or in the
+ * Prometheus text format.
+ */
+void	print_snapshot(t_stats_head *head, t_stats_view *views, int prom)
+{
+	struct timespec	ts;
+	int				i;
+
+	i = -1;
+	while (++i < head->n)
+		stats_read(&head->slots[i], &views[i]);
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	if (prom)
+		print_prom(head, views);
+	else
+		print_table(head, views, ts.tv_sec * 1000000LL + ts.tv_nsec / 1000
+			- head->mono_origin);
+	fflush(stdout);
+}
@@ -0,0 +1,80 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_strategy.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:32:08 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:08:38 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Even philos take the left fork first, odd ones the right one, so that
+ * two neighbours always compete for the same first fork.
+ */
+static void	order_parity(t_philo *p)
+{
+	p->first_fork = p->left_fork;
+	p->second_fork = p->right_fork;
+	if (p->id % 2 != 0)
+	{
+		p->first_fork = p->right_fork;
+		p->second_fork = p->left_fork;
+	}
+}
+
+/**
+ * Resource hierarchy: forks are taken in the order of their index, so no
+ * cycle of waiters can form.
+ */
+static void	order_hierarchy(t_philo *p)
+{
+	p->first_fork = p->left_fork;
+	p->second_fork = p->right_fork;
+	if (p->right_fork < p->left_fork)
+	{
+		p->first_fork = p->right_fork;
+		p->second_fork = p->left_fork;
+	}
+}
+
+/**
+ * Everyone takes the left fork first: it would deadlock on its own, the
+ * waiter is what makes it safe.
+ */
+static void	order_left(t_philo *p)
+{
+	p->first_fork = p->left_fork;
+	p->second_fork = p->right_fork;
+}
+
+/**
+ * Installs the strategy chosen with --strategy and sets every philo up for
+ * it. The waiter admits n - 1 diners at the table (n / 2 with waiter-half),
+ * admitted in the order they asked for a seat (see take_seat). The waiter
+ * staggers the start as parity does: otherwise the first diners, all
+ * reaching left first, would each wait for the fork of the one before.
+ */
+void	strategy_init(t_shared *shared)
+{
+	static const t_strategy	strategies[] = {
+	{1, order_parity, take_locked, put_locked},
+	{0, order_hierarchy, take_locked, put_locked},
+	{1, order_left, take_seated, put_locked},
+	{1, order_left, take_seated, put_locked},
+	{0, setup_cm, take_cm, put_cm}};
+	int						i;
+
+	shared->strategy = strategies[shared->opts.strategy];
+	atomic_init(&shared->seat_tickets, 0);
+	atomic_init(&shared->seats, shared->n_philos - 1);
+	if (shared->opts.strategy == STRAT_WAITER_HALF)
+		atomic_init(&shared->seats, shared->n_philos / 2);
+	i = 0;
+	while (i < shared->n_philos)
+		shared->strategy.setup(&shared->philos[i++]);
+}
@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_strategy_locks.c                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 17:36:51 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:08:38 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Takes the nth fork with its lock. held counts the forks taken so far, for
+ * put_locked to know what to give back.
+ */
+void	take_locked(t_philo *p, int nth)
+{
+	if (nth == 0)
+		fork_lock(p->first_fork, &p->qnodes[0], p->id);
+	else
+		fork_lock(p->second_fork, &p->qnodes[1], p->id);
+	p->held = nth + 1;
+}
+
+/**
+ * The waiter: before reaching for his first fork a philo needs a seat.
+ * He takes a ticket and is admitted once seats, which every philo leaving
+ * the table moves on by one, is past it: seats go in the order they were
+ * asked for, and a philo who just left can not take his back ahead of a
+ * neighbour already waiting. Meanwhile we sleep on seats, waking up now
+ * and then to check on our own life and on the simulation.
+ */
+static void	take_seat(t_philo *p)
+{
+	atomic_int	*seats;
+	int			ticket;
+	int			admitted;
+
+	seats = &p->shared_resources->seats;
+	ticket = atomic_fetch_add_explicit(&p->shared_resources->seat_tickets, 1,
+			memory_order_relaxed);
+	admitted = atomic_load_explicit(seats, memory_order_acquire);
+	while ((int)((unsigned int)admitted - (unsigned int)ticket) <= 0)
+	{
+		park_wait(seats, admitted,
+			p->shared_resources->engine.n_shards != 0, STRATEGY_POLL_US);
+		verify_death(p);
+		admitted = atomic_load_explicit(seats, memory_order_acquire);
+	}
+	p->seated = 1;
+}
+
+void	take_seated(t_philo *p, int nth)
+{
+	if (nth == 0)
+		take_seat(p);
+	take_locked(p, nth);
+}
+
+/**
+ * Releases the forks held, last taken first, then the seat if any: the
+ * next ticket is admitted, and as we can not tell which of the waiters
+ * holds it, they all wake up to check.
+ */
+void	put_locked(t_philo *p)
+{
+	if (p->held == 2)
+		fork_unlock(p->second_fork);
+	if (p->held >= 1)
+		fork_unlock(p->first_fork);
+	p->held = 0;
+	if (p->seated)
+	{
+		p->seated = 0;
+		atomic_fetch_add_explicit(&p->shared_resources->seats, 1,
+			memory_order_release);
+		park_wake(&p->shared_resources->seats, INT_MAX,
+			p->shared_resources->engine.n_shards != 0);
+	}
+}
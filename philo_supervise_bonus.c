@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_supervise_bonus.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:26:46 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:26:46 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+#ifdef __linux__
+
+/**
+ * Waits for the first child to exit through one pidfd per child, all in a
+ * single epoll set: the parent sleeps in the kernel until then.
+ * Return: 0 if the set could not be built (e.g. no pidfd_open), nothing
+ * was waited for.
+ */
+static int	watch_children(t_shm *shm, int *fds)
+{
+	struct epoll_event	ev;
+	int					ep;
+	int					i;
+	int					ok;
+
+	ep = epoll_create1(EPOLL_CLOEXEC);
+	ok = ep >= 0;
+	ev.events = EPOLLIN;
+	i = -1;
+	while (++i < shm->n)
+	{
+		fds[i] = -1;
+		if (ok)
+			fds[i] = syscall(SYS_pidfd_open, shm->seats[i].pid, 0);
+		ok = ok && fds[i] >= 0 && !epoll_ctl(ep, EPOLL_CTL_ADD, fds[i], &ev);
+	}
+	while (ok && epoll_wait(ep, &ev, 1, -1) < 0 && errno == EINTR)
+		;
+	i = -1;
+	while (++i < shm->n)
+		if (fds[i] >= 0)
+			close(fds[i]);
+	if (ep >= 0)
+		close(ep);
+	return (ok);
+}
+
+#else
+
+static int	watch_children(t_shm *shm, int *fds)
+{
+	(void)shm;
+	(void)fds;
+	return (0);
+}
+
+#endif
+
+/**
+ * The parent, once every child is forked. A child only leaves when the
+ * simulation is over: he died, or was the last to get fed (see unfed). So
+ * we just wait for the first of them to exit, without polling and with no
+ * start delay, then cleanup kills the others. Without pidfds, a blocking
+ * waitpid on any child does the same (and reaps that one).
+ */
+void	supervise(t_shm *shm)
+{
+	int	*fds;
+
+	fds = malloc(shm->n * sizeof(int));
+	if (!fds || !watch_children(shm, fds))
+		waitpid(-1, NULL, 0);
+	free(fds);
+}
@@ -0,0 +1,50 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_virtual.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:20:44 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 19:20:44 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * --virtual-time: the single worker calls this whenever it has nothing left
+ * to run at the current time. Instead of waiting, the clock jumps to the
+ * next thing that can happen: the earliest fiber wake up (next, -1 if every
+ * fiber is blocked) or the earliest deadline, whichever comes first; if it
+ * is the deadline, the death is declared right there, exactly as the death
+ * monitor would. Everything runs on this one thread, in a fixed order, so
+ * two runs with the same parameters give the same log.
+ * The --run-for limit is an event as well: the simulation stops when the
+ * clock would go past it.
+ */
+void	virtual_advance(t_shared *shared, long long next)
+{
+	long long	target;
+	long long	now;
+
+	now = clock_now_us(&shared->clock);
+	target = monitor_check(shared, now);
+	if (target < 0)
+		return ;
+	if (next >= 0 && next < target)
+		target = next;
+	if (target < now)
+		target = now;
+	if (shared->opts.run_for_ms
+		&& target > shared->opts.run_for_ms * 1000)
+	{
+		atomic_store_explicit(&shared->clock.virtual_now,
+			shared->opts.run_for_ms * 1000, memory_order_release);
+		stop_simulation(shared, NULL, 0, 0);
+		return ;
+	}
+	atomic_store_explicit(&shared->clock.virtual_now, target,
+		memory_order_release);
+	monitor_check(shared, target);
+}
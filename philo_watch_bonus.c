@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_watch_bonus.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:05:27 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_bonus.h"
+
+/**
+ * The end of a philo, declared by himself (verify_death) or by his
+ * watchdog, whoever gets here first: the other one never comes back (the
+ * process is about to exit). dying is set under pool_lock, then we wait
+ * for a fork the philo may be taking (see pool_acquire): from there on he
+ * takes no more, and the forks he holds go back to the pool, under
+ * pool_lock, before "died" is logged at now.
+ */
+void	philo_die(t_philo *philo, long long now)
+{
+	pthread_mutex_lock(&philo->pool_lock);
+	if (atomic_exchange(&philo->dying, 1))
+	{
+		pthread_mutex_unlock(&philo->pool_lock);
+		while (1)
+			pause();
+	}
+	pthread_mutex_unlock(&philo->pool_lock);
+	while (atomic_load(&philo->in_pool))
+		futex_wait(&philo->in_pool, 1, 0, -1);
+	pthread_mutex_lock(&philo->pool_lock);
+	while (atomic_load(&philo->holding_forks) > 0)
+	{
+		atomic_fetch_sub(&philo->holding_forks, 1);
+		sem_post(&philo->shm->fork_pool);
+	}
+	log_event(philo, now, ACT_DIED);
+	exit(0);
+}
+
+/**
+ * Sleeps until the deadline of the philo, and once more every time a meal
+ * pushed it further: if it is still the deadline when the clock reaches
+ * it, he is dead, wherever the philo himself is, blocked on the fork pool
+ * included (see philo_die).
+ */
+static void	*watchdog(void *arg)
+{
+	t_philo			*philo;
+	t_sleep_stats	stats;
+	long long		deadline;
+	long long		now;
+
+	philo = (t_philo *)arg;
+	memset(&stats, 0, sizeof(stats));
+	deadline = atomic_load(&philo->deadline);
+	now = clock_now_us(&philo->clock);
+	while (now < deadline)
+	{
+		sleep_until(&philo->clock, deadline, &stats);
+		deadline = atomic_load(&philo->deadline);
+		now = clock_now_us(&philo->clock);
+	}
+	philo_die(philo, now);
+	return (NULL);
+}
+
+/**
+ * Started by every child once his deadline is set, detached, on a small
+ * stack.
+ * Return: 0 if the thread could not be created.
+ */
+int	watchdog_start(t_philo *philo)
+{
+	pthread_attr_t	attr;
+	pthread_t		thread;
+	int				ret;
+
+	pthread_attr_init(&attr);
+	pthread_attr_setstacksize(&attr, WATCHDOG_STACK);
+	pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+	ret = pthread_create(&thread, &attr, watchdog, philo);
+	pthread_attr_destroy(&attr);
+	return (ret == 0);
+}
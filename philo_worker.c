@@ -0,0 +1,113 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_worker.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 18:26:10 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/**
+ * Makes runnable the fibers whose sleep is over.
+ * Return: the wake up time of the next one, -1 if none sleeps.
+ */
+static long long	fire_timers(t_worker *worker)
+{
+	long long	now;
+	t_heap		*timers;
+
+	timers = &worker->timers;
+	now = clock_now_us(&worker->shared->clock);
+	while (timers->size && timers->nodes[0].key <= now)
+	{
+		run_push(worker, &worker->engine->fibers[timers->nodes[0].idx]);
+		heap_pop(timers);
+	}
+	if (!timers->size)
+		return (-1);
+	return (timers->nodes[0].key);
+}
+
+/**
+ * Nothing to run: wait on the bell until the next timer is due (minus the
+ * final spin of sleep_until, spent polling here), or until another worker
+ * hands us a fiber. seen is the bell read before looking at the inbox.
+ * With --virtual-time there is no waiting, the clock moves instead (see
+ * virtual_advance).
+ */
+static void	idle(t_worker *worker, long long next, int seen)
+{
+	const t_clock	*clock;
+	long long		left;
+
+	clock = &worker->shared->clock;
+	if (worker->shared->opts.virtual_time)
+		virtual_advance(worker->shared, next);
+	else if (next < 0)
+		futex_wait(&worker->bell, seen, 0, -1);
+	if (worker->shared->opts.virtual_time || next < 0)
+		return ;
+	left = next - clock_now_us(clock) - clock->spin_us;
+	if (left > 0)
+		futex_wait(&worker->bell, seen, 0, left);
+	else
+		cpu_relax();
+}
+
+/**
+ * The scheduler loop of a worker: runs its fibers one at a time, each until
+ * it sleeps, waits or exits, and returns as soon as the simulation stops
+ * (the fibers left are simply never resumed).
+ */
+void	*worker_main(void *arg)
+{
+	t_worker	*worker;
+	t_fiber		*fiber;
+	long long	next;
+	int			seen;
+
+	worker = (t_worker *)arg;
+	*current_worker() = worker;
+	engine_wait_start(worker->shared);
+	while (simulation_running(worker->shared))
+	{
+		seen = atomic_load_explicit(&worker->bell, memory_order_acquire);
+		take_inbox(worker);
+		next = fire_timers(worker);
+		fiber = run_pop(worker);
+		if (!fiber)
+		{
+			idle(worker, next, seen);
+			continue ;
+		}
+		worker->current = fiber;
+		swapcontext(&worker->sched, &fiber->ctx);
+		worker->current = NULL;
+	}
+	return (NULL);
+}
+
+int	fibers_start(t_shared *shared)
+{
+	pthread_attr_t	attr;
+	int				i;
+	int				ret;
+
+	i = -1;
+	while (++i < shared->engine.n_workers)
+	{
+		pthread_attr_init(&attr);
+		placement_attr(shared, &attr, i, shared->engine.n_workers);
+		ret = pthread_create(&shared->engine.workers[i].thread, &attr,
+				worker_main, &shared->engine.workers[i]);
+		pthread_attr_destroy(&attr);
+		if (ret)
+			return (0);
+	}
+	return (1);
+}
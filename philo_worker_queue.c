@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   philo_worker_queue.c                               :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 04:39:58 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:39:58 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+void	run_push(t_worker *worker, t_fiber *fiber)
+{
+	fiber->next = NULL;
+	if (worker->run_tail)
+		worker->run_tail->next = fiber;
+	else
+		worker->run_head = fiber;
+	worker->run_tail = fiber;
+}
+
+/**
+ * Moves the fibers other workers woke up to the run queue. The inbox is a
+ * stack, it is reversed to keep them in the order they were woken.
+ */
+void	take_inbox(t_worker *worker)
+{
+	t_fiber	*list;
+	t_fiber	*rev;
+	t_fiber	*next;
+
+	list = atomic_exchange_explicit(&worker->inbox, NULL,
+			memory_order_acquire);
+	rev = NULL;
+	while (list)
+	{
+		next = list->next;
+		list->next = rev;
+		rev = list;
+		list = next;
+	}
+	while (rev)
+	{
+		next = rev->next;
+		run_push(worker, rev);
+		rev = next;
+	}
+}
+
+/**
+ * Return: the next fiber to run, taken off the run queue, NULL if there is
+ * none.
+ */
+t_fiber	*run_pop(t_worker *worker)
+{
+	t_fiber	*fiber;
+
+	fiber = worker->run_head;
+	if (!fiber)
+		return (NULL);
+	worker->run_head = fiber->next;
+	if (!worker->run_head)
+		worker->run_tail = NULL;
+	return (fiber);
+}
+
+/**
+ * Makes a fiber runnable on its own worker: straight in the run queue if
+ * that is us, otherwise pushed on the worker's inbox, and its bell rung in
+ * case it is idle.
+ */
+void	fiber_ready(t_engine *engine, t_fiber *fiber)
+{
+	t_worker	*to;
+	t_fiber		*top;
+
+	to = &engine->workers[fiber->worker];
+	if (to == *current_worker())
+	{
+		run_push(to, fiber);
+		return ;
+	}
+	top = atomic_load_explicit(&to->inbox, memory_order_relaxed);
+	fiber->next = top;
+	while (!atomic_compare_exchange_weak_explicit(&to->inbox, &top, fiber,
+			memory_order_release, memory_order_relaxed))
+		fiber->next = top;
+	atomic_fetch_add_explicit(&to->bell, 1, memory_order_release);
+	futex_wake(&to->bell, 1, 0);
+}
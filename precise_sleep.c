@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   precise_sleep.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 13:40:22 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 01:38:20 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+void	sleep_stats_record(t_sleep_stats *stats, long long overshoot)
+{
+	stats->calls++;
+	stats->total_overshoot += overshoot;
+	if (overshoot > stats->max_overshoot)
+		stats->max_overshoot = overshoot;
+}
+
+/**
+ * Sleeps until the clock reads deadline (microseconds since its origin).
+ * Most of the wait is a clock_nanosleep on an absolute CLOCK_MONOTONIC time,
+ * so a late wake up is never carried over to the next sleep like a relative
+ * usleep would; it stops clock->spin_us early and the last stretch is spent
+ * spinning on the clock, which is what makes the wake up precise.
+ * Return: the overshoot (time read on wake up - deadline), also recorded in
+ * stats when it is not NULL.
+ */
+long long	sleep_until(const t_clock *clock, long long deadline,
+		t_sleep_stats *stats)
+{
+	struct timespec	ts;
+	long long		wake;
+	long long		now;
+
+	now = clock_now_us(clock);
+	if (deadline - now > clock->spin_us)
+	{
+		wake = clock->mono_origin + deadline - clock->spin_us;
+		ts.tv_sec = wake / 1000000;
+		ts.tv_nsec = (wake % 1000000) * 1000;
+		while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL)
+			== EINTR)
+			;
+		now = clock_now_us(clock);
+	}
+	while (now < deadline)
+		now = clock_now_us(clock);
+	if (stats)
+		sleep_stats_record(stats, now - deadline);
+	return (now - deadline);
+}
+
+/**
+ * Measures how late clock_nanosleep wakes up on this machine and makes that
+ * (with some margin, between 50us and 1ms) the length of the final spin.
+ */
+void	sleep_calibrate(t_clock *clock)
+{
+	t_sleep_stats	stats;
+	int				i;
+
+	stats.calls = 0;
+	stats.total_overshoot = 0;
+	stats.max_overshoot = 0;
+	clock->spin_us = 0;
+	i = 0;
+	while (i++ < 5)
+		sleep_until(clock, clock_now_us(clock) + 1000, &stats);
+	clock->spin_us = stats.max_overshoot * 2;
+	if (clock->spin_us < 50)
+		clock->spin_us = 50;
+	if (clock->spin_us > 1000)
+		clock->spin_us = 1000;
+}
+
+void	sleep_stats_add(t_sleep_stats *dst, const t_sleep_stats *src)
+{
+	dst->calls += src->calls;
+	dst->total_overshoot += src->total_overshoot;
+	if (src->max_overshoot > dst->max_overshoot)
+		dst->max_overshoot = src->max_overshoot;
+}
+
+void	sleep_stats_print(const char *who, const t_sleep_stats *stats)
+{
+	long long	avg;
+
+	avg = 0;
+	if (stats->calls)
+		avg = stats->total_overshoot / stats->calls;
+	fprintf(stderr, "%s sleep: calls=%lld avg_overshoot_us=%lld "
+		"max_overshoot_us=%lld\n", who, stats->calls, avg,
+		stats->max_overshoot);
+}
@@ -0,0 +1,115 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_file.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 22:14:26 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 03:26:25 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+size_t	stats_size(int n)
+{
+	return (sizeof(t_stats_head) + (size_t)n * sizeof(t_stats_slot));
+}
+
+/**
+ * Creates (or truncates) the stats file for n philos and maps it shared,
+ * so that the threads, or the forked children, all update the same pages
+ * and any reader mapping the file sees them live.
+ * Return: the mapping, NULL on failure.
+ */
+t_stats_head	*stats_create(const char *path, int n)
+{
+	t_stats_head	*head;
+	int				fd;
+	int				i;
+
+	fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (NULL);
+	head = MAP_FAILED;
+	if (ftruncate(fd, stats_size(n)) == 0)
+		head = mmap(NULL, stats_size(n), PROT_READ | PROT_WRITE, MAP_SHARED,
+				fd, 0);
+	close(fd);
+	if (head == MAP_FAILED)
+		return (NULL);
+	head->version = STATS_VERSION;
+	head->n = n;
+	head->pid = getpid();
+	atomic_init(&head->running, 1);
+	i = -1;
+	while (++i < n)
+		atomic_init(&head->slots[i].state, ACT_THINK);
+	head->magic = STATS_MAGIC;
+	return (head);
+}
+
+void	stats_close(t_stats_head *head)
+{
+	if (!head)
+		return ;
+	atomic_store_explicit(&head->running, 0, memory_order_release);
+	munmap(head, stats_size(head->n));
+}
+
+/**
+ * Writer side of the seqlock (one writer per slot): seq goes odd, the
+ * fields are stored, seq goes even again. The fence keeps the stores of
+ * the fields after the odd seq, the release store keeps them before the
+ * even one.
+ */
+void	stats_write(t_stats_slot *slot, const t_stats_view *view)
+{
+	unsigned int	seq;
+
+	seq = atomic_load_explicit(&slot->seq, memory_order_relaxed);
+	atomic_store_explicit(&slot->seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&slot->state, view->state, memory_order_relaxed);
+	atomic_store_explicit(&slot->times_eaten, view->times_eaten,
+		memory_order_relaxed);
+	atomic_store_explicit(&slot->fork_wait_us, view->fork_wait_us,
+		memory_order_relaxed);
+	atomic_store_explicit(&slot->last_meal_us, view->last_meal_us,
+		memory_order_relaxed);
+	atomic_store_explicit(&slot->seq, seq + 2, memory_order_release);
+}
+
+/**
+ * Reader side: never blocks the writer, retries while a write is in
+ * progress (odd seq) or happened meanwhile (seq changed). A writer killed
+ * in the middle of stats_write (a bonus child at the end of the run) leaves
+ * seq odd for good: after STATS_READ_RETRIES tries the slot is reported
+ * stale, as last read.
+ */
+void	stats_read(t_stats_slot *slot, t_stats_view *view)
+{
+	unsigned int	seq;
+	int				tries;
+
+	view->stale = 0;
+	tries = 0;
+	while (tries++ < STATS_READ_RETRIES)
+	{
+		seq = atomic_load_explicit(&slot->seq, memory_order_acquire);
+		view->state = atomic_load_explicit(&slot->state, memory_order_relaxed);
+		view->times_eaten = atomic_load_explicit(&slot->times_eaten,
+				memory_order_relaxed);
+		view->fork_wait_us = atomic_load_explicit(&slot->fork_wait_us,
+				memory_order_relaxed);
+		view->last_meal_us = atomic_load_explicit(&slot->last_meal_us,
+				memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		if (!(seq & 1)
+			&& seq == atomic_load_explicit(&slot->seq, memory_order_relaxed))
+			return ;
+		sched_yield();
+	}
+	view->stale = 1;
+}
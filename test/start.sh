@@ -168,12 +168,59 @@ test_six ()
     pkill $1
 }
 
+test_seven ()
+{
+    echo "\e[94m[+] Test #7: 10 seconds for every strategy, engine and fork lock, please wait...\e[0m"
+    for opt in --strategy=parity --strategy=hierarchy --strategy=waiter \
+        --strategy=waiter-half --strategy=chandy-misra --engine=threads \
+        --engine=fibers --engine=shards --fork-lock=pthread \
+        --fork-lock=ticket --fork-lock=mcs --fork-lock=adaptive; do
+        "$2/$1/$1" $opt --run-for=10000 4 410 200 200 > "./log_$1"
+        if [ "$?" -eq 0 ] && ! grep -q died "./log_$1"; then
+            echo "\t\e[92m[+] Test #7 $opt Succeeded\e[0m"
+        else
+            echo "\t\e[91m[+] Test #7 $opt Failed\e[0m"
+            error_log $1 "Test #7" "Given $opt --run-for=10000 4 410 200 200 arguments to $1, no philosopher should die !"
+        fi
+    done
+    rm -rf "./log_$1"
+}
+
+# The forks taken, in rounds of 100ms sorted by id: a replayed run may log
+# a line 1ms off the recorded one, or two lines of the same ms swapped.
+fork_order ()
+{
+    awk '/has taken a fork/ {print int(($1 + 50) / 100), $2}' "$1" \
+        | sort -n -k1,1 -k2,2 > "$1.order"
+}
+
+test_eight ()
+{
+    "$2/$1/$1" --record="./trace_$1" 5 800 200 200 6 > "./log_$1"
+    "$2/$1/$1" --replay="./trace_$1" 5 800 200 200 6 > "./log_$1_replay"
+    fork_order "./log_$1"
+    fork_order "./log_$1_replay"
+    # Once everybody is fed the last takes may or may not be logged.
+    n=$(wc -l < "./log_$1.order")
+    m=$(wc -l < "./log_$1_replay.order")
+    if [ $m -lt $n ];then
+        n=$m
+    fi
+    if [ $n -ge 20 ] && cmp -s <(head -n $n "./log_$1.order") <(head -n $n "./log_$1_replay.order");then
+        echo "\e[92m[+] Test #8 Succeeded\e[0m"
+    else
+        echo "\e[91m[+] Test #8 Failed\e[0m"
+        error_log $1 "Test #8" "Given --replay of a --record run of 5 800 200 200 6 to $1, the forks should be taken in the recorded order !"
+    fi
+    rm -rf "./trace_$1" "./log_$1" "./log_$1.order" "./log_$1_replay" "./log_$1_replay.order"
+}
+
 if [ "$2" -eq 1 -o "$2" -eq 0 ];then
 
     echo "[============[Testing philo]==============]\n"
 
     target="philo"
-    make -C "$1/$target" > /dev/null
+    make -C "$1/$target" $target > /dev/null
 
     if [ "$?" -ne 0 ];then
         echo "\n[+] There's a problem while compiling $target, please recheck your inputs"
@@ -193,6 +240,10 @@ if [ "$2" -eq 1 -o "$2" -eq 0 ];then
     test_four $target $1 15 60 4
 
     test_five $target $1
+
+    test_seven $target $1
+
+    test_eight $target $1
     rm -rf "./log_$target"
 fi
 
@@ -201,7 +252,7 @@ if [ "$2" -eq 2 -o "$2" -eq 0 ];then
     echo "\n[============[Testing philo_bonus]==============]\n"
 
     target="philo_bonus"
-    make -C "$1/$target" > /dev/null
+    make -C "$1/$target" $target > /dev/null
 
     if [ "$?" -ne 0 ];then
         echo "\n[+] There's a problem while compiling $target, please recheck your inputs"
@@ -223,5 +274,7 @@ if [ "$2" -eq 2 -o "$2" -eq 0 ];then
     test_five $target $1
 
     test_six $target $1
+
+    test_eight $target $1
     rm -rf "./log_$target"
 fi
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timing.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 02:53:35 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:53:35 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * xorshift64*: the next number of the sequence of *state (never 0).
+ */
+static unsigned long long	rng_next(unsigned long long *state)
+{
+	*state ^= *state >> 12;
+	*state ^= *state << 25;
+	*state ^= *state >> 27;
+	return (*state * 0x2545F4914F6CDD1DULL);
+}
+
+/**
+ * The state of the generator of philo id for the given seed (splitmix64 of
+ * both): the same seed draws the same jitter for the same philo, run after
+ * run, whatever the engine or the order they run in.
+ */
+unsigned long long	rng_seed(unsigned long long seed, int id)
+{
+	unsigned long long	z;
+
+	z = seed + (unsigned long long)id * 0x9E3779B97F4A7C15ULL;
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+	return ((z ^ (z >> 31)) | 1);
+}
+
+/**
+ * A meal or a sleep of ms milliseconds, in microseconds, with the jitter
+ * of cfg drawn from *rng: uniform in +-jitter_ms, or normal with jitter_ms
+ * of standard deviation (the sum of 12 uniforms in [0, 1), less 6, is close
+ * enough). Never negative. Without jitter nothing is drawn.
+ */
+long long	timing_us(const t_config *cfg, int ms, unsigned long long *rng)
+{
+	long long	us;
+	long long	amp;
+	double		sum;
+	int			i;
+
+	us = ms * 1000LL;
+	if (cfg->jitter == JITTER_NONE)
+		return (us);
+	amp = cfg->jitter_ms * 1000LL;
+	if (cfg->jitter == JITTER_UNIFORM)
+		us += (long long)(rng_next(rng) % (2 * amp + 1)) - amp;
+	else
+	{
+		sum = -6.0;
+		i = 0;
+		while (i++ < 12)
+			sum += (rng_next(rng) >> 11) * (1.0 / 9007199254740992.0);
+		us += (long long)(sum * amp);
+	}
+	if (us < 0)
+		return (0);
+	return (us);
+}
+
+/**
+ * Sets the jitter of c from value: "none", or "uniform:<ms>" or
+ * "normal:<ms>".
+ * Return: 0 if value is none of those.
+ */
+int	jitter_parse(t_config *c, const char *value)
+{
+	static const char	*names[] = {"uniform:", "normal:", NULL};
+	size_t				len;
+	int					i;
+
+	c->jitter = JITTER_NONE;
+	c->jitter_ms = 0;
+	if (!strcmp(value, "none"))
+		return (1);
+	i = -1;
+	while (names[++i])
+	{
+		len = ft_strlen(names[i]);
+		if (!strncmp(value, names[i], len))
+		{
+			c->jitter = JITTER_UNIFORM + i;
+			c->jitter_ms = parse_num(value + len);
+			return (c->jitter_ms >= 0);
+		}
+	}
+	return (0);
+}
+
+/**
+ * Return: 1 if cfg holds valid timings (positive durations, a positive
+ * number of meals or -1 for no limit, a known jitter not below 0).
+ */
+int	timing_valid(const t_config *cfg)
+{
+	return (cfg->time_to_die > 0 && cfg->time_to_eat > 0
+		&& cfg->time_to_sleep > 0 && cfg->jitter_ms >= 0
+		&& (cfg->num_of_eating_times > 0 || cfg->num_of_eating_times == -1));
+}
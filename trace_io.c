@@ -0,0 +1,127 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_io.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 19:52:30 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 02:59:53 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+int	write_all(int fd, const void *buf, size_t len)
+{
+	ssize_t	done;
+
+	while (len)
+	{
+		done = write(fd, buf, len);
+		if (done < 0 && errno == EINTR)
+			continue ;
+		if (done <= 0)
+			return (0);
+		buf = (const char *)buf + done;
+		len -= done;
+	}
+	return (1);
+}
+
+int	read_all(int fd, void *buf, size_t len)
+{
+	ssize_t	done;
+
+	while (len)
+	{
+		done = read(fd, buf, len);
+		if (done < 0 && errno == EINTR)
+			continue ;
+		if (done <= 0)
+			return (0);
+		buf = (char *)buf + done;
+		len -= done;
+	}
+	return (1);
+}
+
+/**
+ * Creates a trace file (--record) and writes its header: the magic
+ * "PHTR", the format version, the kind of trace and the number of forks
+ * (TRACE_FORKS) or philos (TRACE_POOL) it was taken with. Integers are
+ * written in the byte order of the machine: a trace is meant to be
+ * replayed where it was recorded.
+ * Return: the file descriptor, -1 on error.
+ */
+int	trace_create(const char *path, int kind, int n)
+{
+	unsigned int	header[4];
+	int				fd;
+
+	fd = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return (-1);
+	memcpy(header, TRACE_MAGIC, 4);
+	header[1] = TRACE_VERSION;
+	header[2] = kind;
+	header[3] = n;
+	if (!write_all(fd, header, sizeof(header)))
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * Opens a trace (--replay) and checks its header against the kind and the
+ * size of the table we are about to run.
+ * Return: the file descriptor, positioned past the header, -1 if the file
+ * can not be read or is not such a trace.
+ */
+int	trace_open(const char *path, int kind, int n)
+{
+	unsigned int	header[4];
+	int				fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (-1);
+	if (!read_all(fd, header, sizeof(header))
+		|| memcmp(header, TRACE_MAGIC, 4) || header[1] != TRACE_VERSION
+		|| header[2] != (unsigned int)kind || header[3] != (unsigned int)n)
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * The whole content of the text file at path, NUL terminated, in a buffer
+ * the caller frees. NULL if it can not be read.
+ */
+char	*read_file(const char *path)
+{
+	char	*buf;
+	off_t	len;
+	int		fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	buf = NULL;
+	len = lseek(fd, 0, SEEK_END);
+	if (len >= 0 && lseek(fd, 0, SEEK_SET) == 0)
+		buf = malloc(len + 1);
+	if (buf && !read_all(fd, buf, len))
+	{
+		free(buf);
+		buf = NULL;
+	}
+	if (buf)
+		buf[len] = '\0';
+	close(fd);
+	return (buf);
+}
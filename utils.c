@@ -6,13 +6,12 @@
 /*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/09/22 23:28:01 by amarabin          #+#    #+#             */
-/*   Updated: 2023/11/17 15:40:58 by amarabin         ###   ########.fr       */
+/*   Updated: 2026/10/17 01:19:50 by amarabin         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <stddef.h>
 #include <stdlib.h>
-#include <sys/time.h>
 
 int	ft_atoi(char *nptr)
 {
@@ -81,11 +80,3 @@ char	*ft_ulltoa(unsigned long long n)
 	}
 	return (get_ulltoa_str(n, l));
 }
-
-long long	get_timestamp(void)
-{
-	struct timeval	tv;
-
-	gettimeofday(&tv, NULL);
-	return (((tv.tv_sec) * 1000 + (tv.tv_usec)) / 1000);
-}
@@ -0,0 +1,175 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   workload.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: amarabin <amarabin@student.42.fr>          +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/17 02:54:05 by amarabin          #+#    #+#             */
+/*   Updated: 2026/10/17 04:47:59 by amarabin         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo_common.h"
+
+/**
+ * "seed <n>" or "philos <n>" (the latter only before the first selector:
+ * the timings are sized on it).
+ */
+static int	set_global(t_workload *wl, const char *key, char *value)
+{
+	long long	v;
+
+	if (!value)
+		return (0);
+	v = parse_num(value);
+	if (!strcmp(key, "seed"))
+	{
+		wl->seed = v;
+		return (v >= 0);
+	}
+	if (wl->timings || v <= 1)
+		return (0);
+	wl->n = v;
+	return (1);
+}
+
+/**
+ * Reads the selector of a line: "all", "<id>" or "<first>-<last>" (ids
+ * from 1, both included) into range. The timings are allocated with the
+ * first selector (there have to be two philos by then), every philo
+ * starting with the defaults.
+ */
+static int	select_range(t_workload *wl, const t_config *defaults, char *tok,
+		int *range)
+{
+	char	*dash;
+	int		i;
+
+	if (!wl->timings)
+	{
+		if (wl->n > 1)
+			wl->timings = malloc(wl->n * sizeof(t_config));
+		if (!wl->timings)
+			return (0);
+		i = 0;
+		while (i < wl->n)
+			wl->timings[i++] = *defaults;
+	}
+	range[0] = 1;
+	range[1] = wl->n;
+	if (!strcmp(tok, "all"))
+		return (1);
+	dash = strchr(tok, '-');
+	if (dash)
+		*dash++ = '\0';
+	range[0] = parse_num(tok);
+	range[1] = range[0];
+	if (dash)
+		range[1] = parse_num(dash);
+	return (range[0] >= 1 && range[0] <= range[1] && range[1] <= wl->n);
+}
+
+/**
+ * One "<field>=<value>" of a selector line, for one philo.
+ */
+static int	set_field(t_config *c, const char *tok)
+{
+	static const char	*names[] = {"die=", "eat=", "sleep=", "meals=", NULL};
+	int *const			fields[] = {&c->time_to_die, &c->time_to_eat,
+		&c->time_to_sleep, &c->num_of_eating_times};
+	size_t				len;
+	int					i;
+
+	i = -1;
+	while (names[++i])
+	{
+		len = ft_strlen(names[i]);
+		if (!strncmp(tok, names[i], len))
+		{
+			*fields[i] = parse_num(tok + len);
+			return (*fields[i] > 0);
+		}
+	}
+	if (strncmp(tok, "jitter=", 7))
+		return (0);
+	return (jitter_parse(c, tok + 7));
+}
+
+/**
+ * One line of the file, anything after a '#' being a comment.
+ * Return: 0 if it is not valid.
+ */
+static int	apply_line(t_workload *wl, const t_config *defaults, char *line)
+{
+	char	*tok;
+	int		range[2];
+	int		i;
+
+	tok = strchr(line, '#');
+	if (tok)
+		*tok = '\0';
+	tok = next_token(&line);
+	if (!tok)
+		return (1);
+	if (!strcmp(tok, "seed") || !strcmp(tok, "philos"))
+		return (set_global(wl, tok, next_token(&line)) && !next_token(&line));
+	if (!select_range(wl, defaults, tok, range))
+		return (0);
+	tok = next_token(&line);
+	while (tok)
+	{
+		i = range[0] - 1;
+		while (i < range[1])
+			if (!set_field(&wl->timings[i++], tok))
+				return (0);
+		tok = next_token(&line);
+	}
+	return (1);
+}
+
+/**
+ * Parses the --workload file at path, once, before anything starts: what
+ * the philos do then is only read from wl->timings.
+ * The file is made of lines, applied in order (a later line overrides what
+ * an earlier one set), blank lines and '#' comments being ignored:
+ *  seed <n>                the seed of the jitter (1 if not given)
+ *  philos <n>              the size of the table (wl->n by default, from
+ *                          the positional parameters), before any selector
+ *  <selector> <field>...   with a selector "all", "<id>" or "<a>-<b>" and
+ *                          fields die=, eat=, sleep= (ms), meals= and
+ *                          jitter=none|uniform:<ms>|normal:<ms>
+ * Every philo starts with the timings of defaults; without any selector
+ * line timings stays NULL, they all keep them (see table_params for the
+ * check of the result).
+ * Return: 0, after saying why, if the file can not be read or a line is
+ * not valid.
+ */
+int	workload_load(const char *path, const t_config *defaults,
+		t_workload *wl)
+{
+	char	*buf;
+	char	*line;
+	char	*next;
+	int		nr;
+
+	wl->seed = 1;
+	buf = read_file(path);
+	if (!buf)
+		printf("Could not read the workload: %s\n", path);
+	nr = 0;
+	line = buf;
+	while (line && ++nr)
+	{
+		next = strchr(line, '\n');
+		if (next)
+			*next++ = '\0';
+		if (!apply_line(wl, defaults, line))
+			break ;
+		line = next;
+	}
+	free(buf);
+	if (buf && line)
+		printf("Invalid workload: %s, line %d\n", path, nr);
+	return (buf && !line);
+}